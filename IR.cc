@@ -3,15 +3,18 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Local.h>
+#include <sstream>
 #include "IR.h"
+#include "diagnostics.h"
+#include "mir.h"
 #include "optimize.h"
+#include "remarks.h"
+#include "target_gen.h"
+#include "time_report.h"
 
 #define ISTYPE(value, id) (value->getType()->getTypeID() == id)
 
-extern std::string OptimizationLevel;
-extern const char *yyfile;
-extern int yynerrs;
-
 /*
  * @TODO:
  * 1. Array in Struct, Array in Struct Array ...
@@ -21,10 +24,11 @@ extern int yynerrs;
  * 5. SWITCH ...
  */
 
-static Type *TypeOf(const AST_Identifier &type, CodeGenContext &context)
+static Type *TypeOf(const AST_Identifier &type)
 {
-    // Get llvm::type of variable baseD on its identifier.
-    return context.typeSystem.getVarType(type);
+    // Array type when allocation, pointer type when pass parameters.
+    assert(type.isType);
+    return type.isArray ? PointerType::get(type.resolvedType, 0) : type.resolvedType;
 }
 
 static Value *CastToBoolean(CodeGenContext &context, Value *condValue)
@@ -44,7 +48,7 @@ static Value *CastToBoolean(CodeGenContext &context, Value *condValue)
 
 static llvm::Value *calcArrayIndex(shared_ptr<AST_ArrayIndex> index, CodeGenContext &context)
 {
-    auto sizeVec = context.getArraySize(index->arrayName->name);
+    auto &sizeVec = index->arrayName->symbol->arraySizes;
 #ifdef IR_DEBUG
     std::cout << "dimension: " << sizeVec.size() << ", expressions: " << index->expressions->size() << std::endl;
 #endif
@@ -74,6 +78,26 @@ static llvm::Value *calcArrayIndex(shared_ptr<AST_ArrayIndex> index, CodeGenCont
     return expression->generateCode(context);
 }
 
+/*
+ * removeDeadBranches: branch unconditionally on the conditions the AST folding
+ * reduced to a constant, and remove the blocks only their dead side reached.
+ */
+static void removeDeadBranches(Module &module)
+{
+    for (auto &function : module)
+    {
+        bool folded = false;
+        for (auto &block : function)
+        {
+            folded |= ConstantFoldTerminator(&block);
+        }
+        if (folded)
+        {
+            removeUnreachableBlocks(function);
+        }
+    }
+}
+
 void CodeGenContext::generateCode(AST_Block &root)
 {
 #ifdef IR_DEBUG
@@ -84,22 +108,164 @@ void CodeGenContext::generateCode(AST_Block &root)
     Function *mainFunc = Function::Create(mainFuncType, GlobalValue::ExternalLinkage, "main");
     BasicBlock *block = BasicBlock::Create(this->llvmContext, "entry");
 
-    pushBlock(block);
-    Value *retValue = root.generateCode(*this);
-    popBlock();
+    {
+        TimeRegion region("Semantic analysis");
+        analyzeProgram(root, *this);
+    }
+    if (!this->options.MIR || !generateCodeFromMIR(root))
+    {
+        TimeRegion region("IR generation");
+        pushBlock(block);
+        Value *retValue = root.generateCode(*this);
+        popBlock();
+    }
+    if (this->options.FoldAST && errorCount() == 0)
+    {
+        // Only now that the dead branches were checked as well.
+        TimeRegion region("AST folding");
+        removeDeadBranches(*this->theModule);
+    }
+    if (this->debugBuilder)
+    {
+        this->debugBuilder->finalize();
+    }
 #ifdef IR_DEBUG
     std::cout << "Generating code success" << std::endl;
 #endif
-    legacy::PassManager passManager;
+    const Options &options = this->options;
     Optimizer optimizer;
-    optimizer.OptimizationLevel = atoi(&OptimizationLevel.back());
+    optimizer.OptimizationLevel = parseOptimizationLevel(options.OptimizationLevel);
+    optimizer.TM = this->targetMachine.get();
+    // Remarks are reported through this context, the -j workers have their own.
+    optimizer.Threads = remarksRequested(options) ? 0 : options.OptimizationThreads;
+    optimizer.TMFactory = [&options]()
+    {
+        return createTargetMachine(options);
+    };
+    optimizer.ProfileGenerate = options.ProfileGenerate;
+    optimizer.ProfileGenerateDir = options.ProfileGenerateDir;
+    optimizer.ProfileUseFile = options.ProfileUseFile;
 //    std::cout << optimizer.OptimizationLevel << std::endl;
-    optimizer.addStandardCompilePasses(passManager);
+    {
+        TimeRegion region("Optimization");
+        // A failure is reported and counted, the compile stops before code generation.
+        optimizer.optimize(this->theModule);
+    }
 #ifdef OBJ_DEBUG
-    passManager.add(createPrintModulePass(outs()));
+    this->theModule->print(outs(), nullptr);
 #endif
+}
 
-    passManager.run(*(this->theModule));
+bool CodeGenContext::generateCodeFromMIR(AST_Block &root)
+{
+    const Options &options = this->options;
+    mir::Module module;
+    mir::Statistics statistics;
+    std::string reason;
+    bool lowered;
+    {
+        TimeRegion region("MIR lowering");
+        lowered = mir::lowerProgram(root, *this, options.BoundsCheck, module, reason);
+    }
+    if (!lowered)
+    {
+        if (options.BoundsCheck)
+        {
+            reportDiagnostic("\033[1m%s:\033[1;35m warning: \033[0mno bounds checks, the program is not lowered to "
+                             "MIR at %s:%s [-fbounds-check]\n", diagnosticFile(), diagnosticFile(), reason.c_str());
+        } else if (options.MIRStats)
+        {
+            reportDiagnostic("\033[1m%s:\033[1;34m remark: \033[0mnot lowered to MIR at %s:%s [-mir-stats]\n",
+                             diagnosticFile(), diagnosticFile(), reason.c_str());
+        }
+        return false;
+    }
+    {
+        TimeRegion region("MIR passes");
+        // Like the optimizer's inliner, only when optimizing.
+        if (parseOptimizationLevel(options.OptimizationLevel) > 0)
+        {
+            mir::inlineCalls(module, statistics);
+        }
+        mir::analyzeLoops(module, statistics);
+        mir::removeBoundsChecks(module, statistics);
+    }
+    if (options.DumpMIR)
+    {
+        std::ostringstream dump;
+        mir::printModule(module, dump);
+        mirDump = dump.str();
+    }
+    if (options.MIRStats)
+    {
+        for (auto &function : module.functions)
+        {
+            statistics.instructions += function.instructions.size();
+        }
+        reportDiagnostic("\033[1m%s:\033[1;34m remark: \033[0m%zu MIR instructions in %zu bytes, %u calls inlined, "
+                         "%u of %u loops counted, %u of %u bounds checks removed [-mir-stats]\n", diagnosticFile(),
+                         statistics.instructions, module.bytes(), statistics.inlinedCalls, statistics.countedLoops,
+                         statistics.loops, statistics.boundsChecksRemoved, statistics.boundsChecks);
+    }
+    {
+        TimeRegion region("IR generation");
+        mir::emitModule(module, *this);
+    }
+    return true;
+}
+
+void CodeGenContext::enableDebugLocations(const std::string &filename)
+{
+    SmallString<128> directory;
+    sys::fs::current_path(directory);
+    this->debugBuilder = llvm::make_unique<DIBuilder>(*this->theModule);
+    this->debugFile = this->debugBuilder->createFile(filename, directory);
+    // Line tables are enough for remarks, and leave the optimizer's output unchanged.
+    this->debugBuilder->createCompileUnit(dwarf::DW_LANG_C, this->debugFile, "slang",
+                                          parseOptimizationLevel(this->options.OptimizationLevel) > 0, "", 0, StringRef(),
+                                          DICompileUnit::LineTablesOnly);
+    this->theModule->addModuleFlag(Module::Warning, "Debug Info Version", DEBUG_METADATA_VERSION);
+    this->theModule->addModuleFlag(Module::Warning, "Dwarf Version", 4);
+}
+
+void CodeGenContext::enterFunctionScope(Function *function, const AST_Node &node)
+{
+    enterFunctionScope(function, node.row, node.col);
+}
+
+void CodeGenContext::enterFunctionScope(Function *function, int row, int col)
+{
+    if (!this->debugBuilder)
+    {
+        return;
+    }
+    DISubroutineType *type = this->debugBuilder->createSubroutineType(this->debugBuilder->getOrCreateTypeArray({}));
+    DISubprogram *subprogram = this->debugBuilder->createFunction(
+            this->debugFile, function->getName(), StringRef(), this->debugFile, row, type, false, true,
+            row, DINode::FlagPrototyped, parseOptimizationLevel(this->options.OptimizationLevel) > 0);
+    function->setSubprogram(subprogram);
+    this->debugScope = subprogram;
+    emitLocation(row, col);
+}
+
+void CodeGenContext::leaveFunctionScope()
+{
+    this->debugScope = nullptr;
+    this->builder.SetCurrentDebugLocation(DebugLoc());
+}
+
+void CodeGenContext::emitLocation(const AST_Node &node)
+{
+    emitLocation(node.row, node.col);
+}
+
+void CodeGenContext::emitLocation(int row, int col)
+{
+    // Outside of a function there are no instructions to locate.
+    if (this->debugScope)
+    {
+        this->builder.SetCurrentDebugLocation(DebugLoc::get(row, col, this->debugScope));
+    }
 }
 
 llvm::Value *AST_Assignment::generateCode(CodeGenContext &context)
@@ -107,24 +273,23 @@ llvm::Value *AST_Assignment::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating assignment of " << this->lhs->name << std::endl;
 #endif
-    Value *dst = context.getSymbolValue(this->lhs->name);
+    Symbol *symbol = this->lhs->symbol;
+    Value *dst = symbol ? symbol->value : nullptr;
     if (dst == nullptr)
     {
         return LogErrorV(this->lhs->row, this->lhs->col, "use of undeclared identifier '" + this->lhs->name + "'");
     }
-    auto dstType = context.getSymbolType(this->lhs->name);
-    std::string dstTypeStr = dstType->name;
     Value *exp = this->rhs->generateCode(context);
     if (exp == nullptr)
     {
         return nullptr;
     }
 #ifdef IR_DEBUG
-    std::cout << "dst typeid = " << TypeSystem::llvmTypeToStr(context.typeSystem.getVarType(dstTypeStr)) << std::endl;
+    std::cout << "dst typeid = " << TypeSystem::llvmTypeToStr(symbol->valueType) << std::endl;
     std::cout << "exp typeid = " << TypeSystem::llvmTypeToStr(exp) << std::endl;
 #endif
 
-    exp = context.typeSystem.cast(exp, context.typeSystem.getVarType(dstTypeStr), context.currentBlock());
+    exp = context.typeSystem.cast(exp, symbol->valueType, context.currentBlock());
     context.builder.CreateStore(exp, dst);
     return dst;
 }
@@ -213,6 +378,7 @@ llvm::Value *AST_Block::generateCode(CodeGenContext &context)
     Value *last = nullptr;
     for (auto it = this->statements->begin(); it != this->statements->end(); it++)
     {
+        context.emitLocation(**it);
         last = (*it)->generateCode(context);
     }
     return last;
@@ -239,7 +405,7 @@ llvm::Value *AST_Identifier::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating identifier " << this->name << std::endl;
 #endif
-    Value *value = context.getSymbolValue(this->name);
+    Value *value = this->symbol ? this->symbol->value : nullptr;
     if (value == nullptr)
     {
         return LogErrorV(this->row, this->col, "use of undeclared identifier '" + this->name + "'");
@@ -275,19 +441,9 @@ llvm::Value *AST_FunctionDeclaration::generateCode(CodeGenContext &context)
 
     for (auto &arg : *this->arguments)
     {
-        if (arg->type->isArray)
-        {
-            argTypes.push_back(PointerType::get(context.typeSystem.getVarType(arg->type->name), 0));
-        } else
-        {
-            argTypes.push_back(TypeOf(*arg->type, context));
-        }
+        argTypes.push_back(TypeOf(*arg->type));
     }
-    Type *retType = nullptr;
-    if (this->type->isArray)
-        retType = PointerType::get(context.typeSystem.getVarType(this->type->name), 0);
-    else
-        retType = TypeOf(*this->type, context);
+    Type *retType = TypeOf(*this->type);
 
     FunctionType *functionType = FunctionType::get(retType, argTypes, false);
     Function *function;
@@ -296,20 +452,28 @@ llvm::Value *AST_FunctionDeclaration::generateCode(CodeGenContext &context)
     {
         function = Function::Create(functionType, GlobalValue::ExternalLinkage, this->id->name,
                                     context.theModule.get());
+        // Calls go to the first declaration, later ones are renamed by the module.
+        if (this->id->symbol->value == nullptr)
+        {
+            this->id->symbol->value = function;
+        }
     } else
     {
         // Check whether this function has been declared before.
-        function = context.theModule->getFunction(this->id->name);
+        function = cast_or_null<Function>(this->id->symbol->value);
         // If not, just create this function as before.
         if (function == nullptr)
         {
             function = Function::Create(functionType, GlobalValue::ExternalLinkage, this->id->name,
                                         context.theModule.get());
+            this->id->symbol->value = function;
         }
+        TimeRegion region("IR generation", this->id->name);
         BasicBlock *basicBlock = BasicBlock::Create(context.llvmContext, "entry", function, nullptr);
 
         context.builder.SetInsertPoint(basicBlock);
         context.pushBlock(basicBlock);
+        context.enterFunctionScope(function, *this->id);
 
         // Declare function parameters.
         auto origin_arg = this->arguments->begin();
@@ -319,15 +483,12 @@ llvm::Value *AST_FunctionDeclaration::generateCode(CodeGenContext &context)
             ir_arg_it.setName((*origin_arg)->id->name);
             Value *argAlloc;
             if ((*origin_arg)->type->isArray)
-                argAlloc = context.builder.CreateAlloca(
-                        PointerType::get(context.typeSystem.getVarType((*origin_arg)->type->name), 0));
+                argAlloc = context.builder.CreateAlloca(TypeOf(*(*origin_arg)->type));
             else
                 argAlloc = (*origin_arg)->generateCode(context);
 
             context.builder.CreateStore(&ir_arg_it, argAlloc, false);
-            context.setSymbolValue((*origin_arg)->id->name, argAlloc, false);
-            context.setSymbolType((*origin_arg)->id->name, (*origin_arg)->type, false);
-            context.setFuncArg((*origin_arg)->id->name, true);
+            (*origin_arg)->id->symbol->value = argAlloc;
             origin_arg++;
         }
 
@@ -335,8 +496,10 @@ llvm::Value *AST_FunctionDeclaration::generateCode(CodeGenContext &context)
         if (context.getCurrentReturnValue())
         {
             context.builder.CreateRet(context.getCurrentReturnValue());
+            context.leaveFunctionScope();
         } else
         {
+            context.leaveFunctionScope();
             return LogErrorV(this->block->row, this->block->col, "control reaches end with no return value");
         }
         context.popBlock();
@@ -350,19 +513,7 @@ llvm::Value *AST_StructDeclaration::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating struct declaration of " << this->name->name << std::endl;
 #endif
-    std::vector<Type *> memberTypes;
-
-    auto structType = StructType::create(context.llvmContext, this->name->name);
-    context.typeSystem.addStructType(this->name->name, structType);
-
-    for (auto &member : *this->members)
-    {
-        context.typeSystem.addStructMember(this->name->name, member->type->name, member->id->name);
-        memberTypes.push_back(TypeOf(*member->type, context));
-    }
-
-    structType->setBody(memberTypes);
-
+    // The semantic analysis has created the struct type already.
     return nullptr;
 }
 
@@ -371,7 +522,7 @@ llvm::Value *AST_MethodCall::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating method call of " << this->id->name << std::endl;
 #endif
-    Function *calleeF = context.theModule->getFunction(this->id->name);
+    Function *calleeF = this->id->symbol ? cast_or_null<Function>(this->id->symbol->value) : nullptr;
     if (calleeF == nullptr)
     {
         return LogErrorV(this->id->row, this->id->col,
@@ -404,7 +555,7 @@ llvm::Value *AST_VariableDeclaration::generateCode(CodeGenContext &context)
     std::cout << "Generating variable declaration of " << this->type->name << " " << this->id->name
               << (this->isGlobal ? " (global)" : "") << std::endl;
 #endif
-    Type *type = TypeOf(*this->type, context);
+    Type *type = TypeOf(*this->type);
 
     Value *inst = nullptr;
 
@@ -419,9 +570,9 @@ llvm::Value *AST_VariableDeclaration::generateCode(CodeGenContext &context)
             arraySizes.push_back(integer->value);
         }
 
-        context.setArraySize(this->id->name, arraySizes);
+        this->id->symbol->arraySizes = arraySizes;
         Value *arraySizeValue = AST_Integer(arraySize).generateCode(context);
-        auto arrayType = ArrayType::get(context.typeSystem.getVarType(this->type->name), arraySize);
+        auto arrayType = ArrayType::get(this->type->resolvedType, arraySize);
         if (isGlobal)
         {
             GlobalVariable *gvar_array_a = new GlobalVariable(*context.theModule, arrayType, false,
@@ -451,11 +602,7 @@ llvm::Value *AST_VariableDeclaration::generateCode(CodeGenContext &context)
         }
     }
 
-    context.setSymbolType(this->id->name, this->type, isGlobal);
-    context.setSymbolValue(this->id->name, inst, isGlobal);
-#ifdef IR_DEBUG
-    context.PrintSymTable();
-#endif
+    this->id->symbol->value = inst;
 
     if (this->assignmentExpr != nullptr)
     {
@@ -589,15 +736,19 @@ llvm::Value *AST_ArrayIndex::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating array index expression of " << this->arrayName->name << std::endl;
 #endif
-    auto varPtr = context.getSymbolValue(this->arrayName->name);
-    auto type = context.getSymbolType(this->arrayName->name);
-    std::string typeStr = type->name;
+    Symbol *symbol = this->arrayName->symbol;
+    if (symbol == nullptr || symbol->value == nullptr)
+    {
+        return LogErrorV(this->arrayName->row, this->arrayName->col,
+                         "use of undeclared identifier '" + this->arrayName->name + "'");
+    }
+    auto varPtr = symbol->value;
 
-    assert(type->isArray);
+    assert(symbol->type->isArray);
 
     auto value = calcArrayIndex(make_shared<AST_ArrayIndex>(*this), context);
     std::vector<Value *> indices;
-    if (context.isFuncArg(this->arrayName->name))
+    if (symbol->isFuncArg)
     {
 #ifdef IR_DEBUG
         std::cout << " is function argument" << std::endl;
@@ -625,7 +776,8 @@ llvm::Value *AST_ArrayAssignment::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating array index assignment of " << this->arrayIndex->arrayName->name << std::endl;
 #endif
-    auto varPtr = context.getSymbolValue(this->arrayIndex->arrayName->name);
+    Symbol *symbol = this->arrayIndex->arrayName->symbol;
+    auto varPtr = symbol ? symbol->value : nullptr;
 
     if (varPtr == nullptr)
     {
@@ -658,7 +810,7 @@ llvm::Value *AST_ArrayInitialization::generateCode(CodeGenContext &context)
         this->declaration->isGlobal = true;
     }
     auto arrayPtr = this->declaration->generateCode(context);
-    auto sizeVec = context.getArraySize(this->declaration->id->name);
+    auto &sizeVec = this->declaration->id->symbol->arraySizes;
 
     // Calculate array size.
     std::vector<uint64_t> dimensions;
@@ -709,7 +861,12 @@ llvm::Value *AST_StructMember::generateCode(CodeGenContext &context)
 #ifdef IR_DEBUG
     std::cout << "Generating struct member expression of " << this->id->name << "." << this->member->name << std::endl;
 #endif
-    auto varPtr = context.getSymbolValue(this->id->name);
+    Symbol *symbol = this->id->symbol;
+    auto varPtr = symbol ? symbol->value : nullptr;
+    if (varPtr == nullptr)
+    {
+        return LogErrorV(this->id->row, this->id->col, "use of undeclared identifier '" + this->id->name + "'");
+    }
     Value *structPtr;
     if (isArray)
     {
@@ -730,9 +887,13 @@ llvm::Value *AST_StructMember::generateCode(CodeGenContext &context)
                          "member reference base type '" + (this->id->name) + "' is not a structure or union");
     }
 
-    string structName = structPtr->getType()->getStructName().str();
-    long memberIndex = context.typeSystem.getStructMemberIndex(structName, this->member->name, this->member->row,
-                                                               this->member->col);
+    long memberIndex = this->memberIndex;
+    if (memberIndex < 0)
+    {
+        LogErrorV(this->member->row, this->member->col, "no member named '" + this->member->name + "' in 'struct " +
+                                                        structPtr->getType()->getStructName().str() + "'");
+        memberIndex = 0;
+    }
 
     std::vector<Value *> indices;
     indices.push_back(ConstantInt::get(context.typeSystem.intTy, 0, false));
@@ -748,7 +909,13 @@ llvm::Value *AST_StructAssignment::generateCode(CodeGenContext &context)
     std::cout << "Generating struct assignment of " << this->structMember->id->name << "."
               << this->structMember->member->name << std::endl;
 #endif
-    auto varPtr = context.getSymbolValue(this->structMember->id->name);
+    Symbol *symbol = this->structMember->id->symbol;
+    auto varPtr = symbol ? symbol->value : nullptr;
+    if (varPtr == nullptr)
+    {
+        return LogErrorV(this->structMember->id->row, this->structMember->id->col,
+                         "use of undeclared identifier '" + this->structMember->id->name + "'");
+    }
     Value *structPtr;
     if (this->structMember->isArray)
     {
@@ -770,10 +937,14 @@ llvm::Value *AST_StructAssignment::generateCode(CodeGenContext &context)
                          "' is not a structure or union");
     }
 
-    string structName = structPtr->getType()->getStructName().str();
-    long memberIndex = context.typeSystem.getStructMemberIndex(structName, this->structMember->member->name,
-                                                               this->structMember->member->row,
-                                                               this->structMember->member->col);
+    long memberIndex = this->structMember->memberIndex;
+    if (memberIndex < 0)
+    {
+        LogErrorV(this->structMember->member->row, this->structMember->member->col,
+                  "no member named '" + this->structMember->member->name + "' in 'struct " +
+                  structPtr->getType()->getStructName().str() + "'");
+        memberIndex = 0;
+    }
 
     std::vector<Value *> indices;
     auto value = this->expression->generateCode(context);
@@ -799,10 +970,8 @@ llvm::Value *AST_Literal::generateCode(CodeGenContext &context)
  */
 std::unique_ptr<AST_Expression> LogError(const int row, const int col, const char *str)
 {
-    fflush(stdout);
-    fprintf(stderr, "\033[1m%s:%d:%d:\033[1;31m error: \033[0m", yyfile, row, col);
-    fprintf(stderr, "\033[1m%s\033[0m\n", str);
-    yynerrs++;
+    reportDiagnostic("\033[1m%s:%d:%d:\033[1;31m error: \033[0m\033[1m%s\033[0m\n", diagnosticFile(), row, col, str);
+    countError();
     return nullptr;
 }
 
@@ -2,9 +2,11 @@
 #define SLANG_IR_H
 
 #include <llvm/IR/Value.h>
+#include <llvm/IR/DIBuilder.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
 #include <json/json.h>
 #include <iostream>
 #include <stack>
@@ -14,26 +16,20 @@
 #include <map>
 #include "absyn.h"
 #include "parser.h"
+#include "sema.h"
 #include "type.h"
 #include "debug.h"
+#include "options.h"
 
 using namespace llvm;
 using std::unique_ptr;
 using std::string;
 
-using SymbolTable = std::map<std::string, Value *>;
-using TypeTable = std::map<std::string, std::shared_ptr<AST_Identifier>>;
-
 class CodeGenBlock
 {
 public:
     BasicBlock *block;
     Value *returnValue;
-    SymbolTable locals;
-    // Type name string of variables.
-    TypeTable types;
-    std::map<string, bool> isFuncArg;
-    std::map<string, std::vector<uint64_t>> arraySizes;
 };
 
 class CodeGenContext
@@ -42,14 +38,27 @@ private:
     std::vector<CodeGenBlock *> blockStack;
 
 public:
+    const Options &options;
+    // -fsave-optimization-record: YAML written by llvmContext, so declared before it.
+    std::string optimizationRecord;
+    unique_ptr<raw_string_ostream> optimizationRecordStream;
+    // -dump-mir: the text form of the MIR, empty if the program was not lowered.
+    std::string mirDump;
     LLVMContext llvmContext;
     IRBuilder<> builder;
     unique_ptr<Module> theModule;
-    SymbolTable globalVars;
-    TypeTable globalTypes;
     TypeSystem typeSystem;
-
-    CodeGenContext(std::string filename) : builder(llvmContext), typeSystem(llvmContext)
+    // What the AST points to after the semantic analysis.
+    SymbolArena symbols;
+    // Shared by the optimization pipeline and the backend.
+    unique_ptr<TargetMachine> targetMachine;
+    // Line-table debug info, only built when optimization remarks need source locations.
+    unique_ptr<DIBuilder> debugBuilder;
+    DIFile *debugFile = nullptr;
+    DIScope *debugScope = nullptr;
+
+    CodeGenContext(std::string filename, const Options &options) :
+            options(options), builder(llvmContext), typeSystem(llvmContext)
     {
         theModule = std::unique_ptr<Module>(new Module(filename, this->llvmContext));
     }
@@ -71,86 +80,6 @@ public:
         }
     }
 
-    Value *getSymbolValue(const std::string &name)
-    {
-        // First, search for the local variables.
-        for (auto it = blockStack.rbegin(); it != blockStack.rend(); it++)
-        {
-            if ((*it)->locals.find(name) != (*it)->locals.end())
-            {
-                return (*it)->locals[name];
-            }
-        }
-        // Then, search for the global variables.
-        if (globalVars.find(name) != globalVars.end())
-        {
-            return globalVars[name];
-        }
-        // Finally ...
-        return nullptr;
-    }
-
-    shared_ptr<AST_Identifier> getSymbolType(const std::string &name)
-    {
-        // First, search for the local variables.
-        for (auto it = blockStack.rbegin(); it != blockStack.rend(); it++)
-        {
-            if ((*it)->types.find(name) != (*it)->types.end())
-            {
-                return (*it)->types[name];
-            }
-        }
-        // Then, search for the global variables.
-        if (globalTypes.find(name) != globalTypes.end())
-        {
-            return globalTypes[name];
-        }
-        // Finally ...
-        return nullptr;
-    }
-
-    void setSymbolValue(const std::string &name, Value *value, bool isGlobal)
-    {
-        if (isGlobal)
-        {
-            globalVars[name] = value;
-        } else
-        {
-            blockStack.back()->locals[name] = value;
-        }
-    }
-
-    void setSymbolType(const std::string &name, shared_ptr<AST_Identifier> value, bool isGlobal)
-    {
-        if (isGlobal)
-        {
-            globalTypes[name] = value;
-        } else
-        {
-            blockStack.back()->types[name] = value;
-        }
-    }
-
-    bool isFuncArg(const std::string &name) const
-    {
-        for (auto it = blockStack.rbegin(); it != blockStack.rend(); it++)
-        {
-            if ((*it)->isFuncArg.find(name) != (*it)->isFuncArg.end())
-            {
-                return (*it)->isFuncArg[name];
-            }
-        }
-        return false;
-    }
-
-    void setFuncArg(const std::string &name, bool value)
-    {
-#ifdef IR_DEBUG
-        std::cout << "Setting " << name << " as function arguments" << std::endl;
-#endif
-        blockStack.back()->isFuncArg[name] = value;
-    }
-
     BasicBlock *currentBlock() const
     {
         return blockStack.back()->block;
@@ -181,54 +110,35 @@ public:
         return blockStack.back()->returnValue;
     }
 
-    void setArraySize(const std::string &name, std::vector<uint64_t> value)
-    {
-#ifdef IR_DEBUG
-        std::cout << "[ARRAY DIMENSION]" << name << ": " << value.size() << std::endl;
-        std::cout << "[ARRAY SIZE     ]" << name << ": ";
-        for (auto &v: value)
-        {
-            std::cout << v << " ";
-        }
-        std::cout << std::endl;
-#endif
-        blockStack.back()->arraySizes[name] = value;
-    }
+    /*
+     * enableDebugLocations: emit a line table for the source file, so that
+     * optimization remarks can be mapped back to Slang rows and columns.
+     */
+    void enableDebugLocations(const std::string &filename);
 
-    std::vector<uint64_t> getArraySize(const std::string &name)
-    {
-        for (auto it = blockStack.rbegin(); it != blockStack.rend(); it++)
-        {
-            if ((*it)->arraySizes.find(name) != (*it)->arraySizes.end())
-            {
-                return (*it)->arraySizes[name];
-            }
-        }
-        return blockStack.back()->arraySizes[name];
-    }
+    /*
+     * enterFunctionScope: attach a DISubprogram to a function about to be generated.
+     */
+    void enterFunctionScope(Function *function, const AST_Node &node);
 
-    void PrintSymTable()
-    {
-        std::cout << "======= Global Symbol Table =======" << std::endl;
-        for (auto it = globalVars.begin(); it != globalVars.end(); it++)
-        {
-            std::cout << it->first << " = " << it->second << " : " << getSymbolType(it->first) << std::endl;
-        }
-        std::cout << "======= Local Symbol Table ========" << std::endl;
-        std::string prefix = "";
-        for (auto it = blockStack.begin(); it != blockStack.end(); it++)
-        {
-            for (auto it2 = (*it)->locals.begin(); it2 != (*it)->locals.end(); it2++)
-            {
-                std::cout << prefix << it2->first << " = " << it2->second << " : " << this->getSymbolType(it2->first)
-                          << std::endl;
-            }
-            prefix += "\t";
-        }
-        std::cout << "===================================" << std::endl;
-    }
+    void enterFunctionScope(Function *function, int row, int col);
+
+    void leaveFunctionScope();
+
+    /*
+     * emitLocation: give the instructions generated next the row and column of the node.
+     */
+    void emitLocation(const AST_Node &node);
+
+    void emitLocation(int row, int col);
 
     void generateCode(AST_Block &root);
+
+    /*
+     * generateCodeFromMIR: -fmir, lower root to the MIR, run its passes and
+     * generate IR from it. False if root is not lowered, with nothing generated.
+     */
+    bool generateCodeFromMIR(AST_Block &root);
 };
 
 Value *LogErrorV(const int row, const int col, const char *str);
@@ -4,11 +4,11 @@
 #include <iostream>
 #include <vector>
 #include <llvm/IR/Value.h>
-#include <json/json.h>
 #include <memory>
 #include <string>
 
 #include "debug.h"
+#include "json_writer.h"
 
 using std::shared_ptr;
 using std::make_shared;
@@ -22,10 +22,42 @@ class AST_Statement;
 
 class AST_VariableDeclaration;
 
+struct Symbol;
+
 typedef std::vector<std::shared_ptr<AST_Expression>> AST_ExpressionList;
 typedef std::vector<std::shared_ptr<AST_Statement>> AST_StatementList;
 typedef std::vector<std::shared_ptr<AST_VariableDeclaration>> AST_VariableList;
 
+/*
+ * ASTKind: the concrete class of a node. The values are stored in -emit-ast
+ * files, new kinds go at the end.
+ */
+enum class ASTKind : uint8_t
+{
+    Expression = 1,
+    Statement,
+    Double,
+    Integer,
+    Identifier,
+    MethodCall,
+    BinaryOperator,
+    Assignment,
+    Block,
+    ExpressionStatement,
+    VariableDeclaration,
+    FunctionDeclaration,
+    StructDeclaration,
+    ReturnStatement,
+    IfStatement,
+    ForStatement,
+    ArrayIndex,
+    ArrayAssignment,
+    ArrayInitialization,
+    StructMember,
+    StructAssignment,
+    Literal
+};
+
 class AST_Node
 {
 public:
@@ -33,26 +65,27 @@ public:
 
     virtual ~AST_Node() = default;
 
-    virtual std::string getTypeName() const = 0;
+    virtual const char *getTypeName() const = 0;
 
-    virtual void print(std::string prefix) const = 0;
+    virtual ASTKind getKind() const = 0;
 
     virtual llvm::Value *generateCode(CodeGenContext &context)
     {
         return static_cast<llvm::Value *>(nullptr);
     }
 
-    virtual Json::Value generateJson() const
-    {
-        return Json::Value();
-    }
+    /*
+     * print: the subtree for -dump-ast, one node per line, see ast_visitor.cc.
+     */
+    void print(const std::string &prefix) const;
 
-    int col;
-    int row;
+    /*
+     * writeJson: stream the subtree for -dump-ast-json, see ast_visitor.cc.
+     */
+    void writeJson(JsonWriter &writer) const;
 
-protected:
-    const std::string DELIMINATER = ":";
-    const std::string PREFIX = "--";
+    int col = 0;
+    int row = 0;
 };
 
 class AST_Expression : public AST_Node
@@ -60,21 +93,14 @@ class AST_Expression : public AST_Node
 public:
     AST_Expression() = default;
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Expression";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::cout << prefix << getTypeName() << std::endl;
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName();
-        return root;
+        return ASTKind::Expression;
     }
 };
 
@@ -86,21 +112,14 @@ public:
 
     AST_Statement() = default;
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Statement";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::cout << prefix << getTypeName() << std::endl;
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + (isGlobal ? "global" : "");
-        return root;
+        return ASTKind::Statement;
     }
 };
 
@@ -114,24 +133,17 @@ public:
     explicit AST_Double(double value) : value(value)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Double";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::cout << prefix << getTypeName() << DELIMINATER << value << std::endl;
+        return ASTKind::Double;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + std::to_string(value);
-        return root;
-    }
 };
 
 class AST_Integer : public AST_Expression
@@ -144,25 +156,18 @@ public:
     explicit AST_Integer(uint64_t value) : value(value)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Integer";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::cout << prefix << getTypeName() << DELIMINATER << value << std::endl;
+        return ASTKind::Integer;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
 
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + std::to_string(value);
-        return root;
-    }
-
     operator AST_Double() const
     {
         return AST_Double(value);
@@ -178,44 +183,23 @@ public:
 
     shared_ptr<AST_ExpressionList> arraySize = make_shared<AST_ExpressionList>();
 
+    // Set by the semantic analysis, see sema.h: what a name refers to, what a type name denotes.
+    Symbol *symbol = nullptr;
+    llvm::Type *resolvedType = nullptr;
+
     AST_Identifier() = default;
 
     explicit AST_Identifier(std::string &name) : name(name)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Identifier";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << name << (isArray ? "(Array)" : "") << std::endl;
-        if (isArray)
-        {
-            assert(arraySize->size() > 0);
-            for (auto it = arraySize->begin(); it != arraySize->end(); it++)
-            {
-                (*it)->print(nextPrefix);
-            }
-        }
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + name + (isArray ? "(Array)" : "");
-        if (isArray)
-        {
-            assert(arraySize->size() > 0);
-            for (auto it = arraySize->begin(); it != arraySize->end(); it++)
-            {
-                root["children"].append((*it)->generateJson());
-            }
-        }
-
-        return root;
+        return ASTKind::Identifier;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -237,39 +221,14 @@ public:
             arguments(arguments)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_MethodCall";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        this->id->print(nextPrefix);
-        if (arguments)
-        {
-            for (auto it = arguments->begin(); it != arguments->end(); it++)
-            {
-                (*it)->print(nextPrefix);
-            }
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(id->generateJson());
-        if (arguments)
-        {
-            for (auto it = arguments->begin(); it != arguments->end(); it++)
-            {
-                root["children"].append((*it)->generateJson());
-            }
-        }
-
-        return root;
+        return ASTKind::MethodCall;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -290,29 +249,14 @@ public:
             rhs(rhs)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_BinaryOperator";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << op << std::endl;
-
-        lhs->print(nextPrefix);
-        rhs->print(nextPrefix);
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + std::to_string(op);
-
-        root["children"].append(lhs->generateJson());
-        root["children"].append(rhs->generateJson());
-
-        return root;
+        return ASTKind::BinaryOperator;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -331,29 +275,14 @@ public:
             rhs(rhs)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Assignment";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-
-        lhs->print(nextPrefix);
-        rhs->print(nextPrefix);
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName();
-
-        root["children"].append(lhs->generateJson());
-        root["children"].append(rhs->generateJson());
-
-        return root;
+        return ASTKind::Assignment;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -366,31 +295,14 @@ public:
 
     AST_Block() = default;
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Block";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        for (auto it = statements->begin(); it != statements->end(); it++)
-        {
-            (*it)->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        for (auto it = statements->begin(); it != statements->end(); it++)
-        {
-            root["children"].append((*it)->generateJson());
-        }
-
-        return root;
+        return ASTKind::Block;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -407,30 +319,14 @@ public:
             : expression(expression)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_ExpressionStatement";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        if (expression != nullptr)
-        {
-            expression->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        if (expression)
-        {
-            root["children"].append(expression->generateJson());
-        }
-        return root;
+        return ASTKind::ExpressionStatement;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -460,35 +356,14 @@ public:
         assert(!type->isArray || (type->isArray && type->arraySize != nullptr));
     }
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_VariableDeclaration";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << (isGlobal ? "[global]" : "") << std::endl;
-        type->print(nextPrefix);
-        id->print(nextPrefix);
-        if (assignmentExpr)
-        {
-            assignmentExpr->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(type->generateJson());
-        root["children"].append(id->generateJson());
-        if (assignmentExpr)
-        {
-            root["children"].append(assignmentExpr->generateJson());
-        }
-
-        return root;
+        return ASTKind::VariableDeclaration;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -517,51 +392,16 @@ public:
         assert(type->isType);
     }
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_FunctionDeclaration";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        type->print(nextPrefix);
-        id->print(nextPrefix);
-
-        for (auto it = arguments->begin(); it != arguments->end(); it++)
-        {
-            (*it)->print(nextPrefix);
-        }
-
-        assert(isExternal || block != nullptr);
-        if (block)
-        {
-            block->print(nextPrefix);
-        }
+        return ASTKind::FunctionDeclaration;
     }
 
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(type->generateJson());
-        root["children"].append(id->generateJson());
-
-        for (auto it = arguments->begin(); it != arguments->end(); it++)
-        {
-            root["children"].append((*it)->generateJson());
-        }
-
-        assert(isExternal || block != nullptr);
-        if (block)
-        {
-            root["children"].append(block->generateJson());
-        }
-
-        return root;
-    };
-
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
 };
 
@@ -578,32 +418,14 @@ public:
             : name(id), members(arguments)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_StructDeclaration";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << name->name << std::endl;
-        for (auto it = members->begin(); it != members->end(); it++)
-        {
-            (*it)->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + name->name;
-
-        for (auto it = members->begin(); it != members->end(); it++)
-        {
-            root["children"].append((*it)->generateJson());
-        }
-
-        return root;
+        return ASTKind::StructDeclaration;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -619,31 +441,14 @@ public:
     explicit AST_ReturnStatement(std::shared_ptr<AST_Expression> expression) : expression(expression)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_ReturnStatement";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        if (expression)
-        {
-            expression->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        if (expression)
-        {
-            root["children"].append(expression->generateJson());
-        }
-
-        return root;
+        return ASTKind::ReturnStatement;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -665,35 +470,14 @@ public:
             falseBlock(falseBlock)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_IfStatement";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        condition->print(nextPrefix);
-        trueBlock->print(nextPrefix);
-        if (falseBlock != nullptr)
-        {
-            falseBlock->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(condition->generateJson());
-        root["children"].append(trueBlock->generateJson());
-        if (falseBlock != nullptr)
-        {
-            root["children"].append(falseBlock->generateJson());
-        }
-
-        return root;
+        return ASTKind::IfStatement;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -721,51 +505,14 @@ public:
         }
     }
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_ForStatement";
     }
 
-    void print(std::string prefix) const override
+    ASTKind getKind() const override
     {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        if (initial)
-        {
-            initial->print(nextPrefix);
-        }
-        if (condition)
-        {
-            condition->print(nextPrefix);
-        }
-        if (increment)
-        {
-            increment->print(nextPrefix);
-        }
-
-        block->print(nextPrefix);
-    }
-
-    Json::Value generateJson() const override
-    {
-        Json::Value root;
-        root["name"] = getTypeName();
-        if (initial)
-        {
-            root["children"].append(initial->generateJson());
-        }
-        if (condition)
-        {
-            root["children"].append(condition->generateJson());
-        }
-        if (increment)
-        {
-            root["children"].append(increment->generateJson());
-        }
-
-        root["children"].append(block->generateJson());
-
-        return root;
+        return ASTKind::ForStatement;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -790,33 +537,14 @@ public:
             : arrayName(name), expressions(list)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_ArrayIndex";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        arrayName->print(nextPrefix);
-        for (auto it = expressions->begin(); it != expressions->end(); it++)
-        {
-            (*it)->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(arrayName->generateJson());
-        for (auto it = expressions->begin(); it != expressions->end(); it++)
-        {
-            root["children"].append((*it)->generateJson());
-        }
-
-        return root;
+        return ASTKind::ArrayIndex;
     }
 
     llvm::Value *generateCode(CodeGenContext &context) override;
@@ -836,26 +564,14 @@ public:
             : arrayIndex(index), expression(exp)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_ArrayAssignment";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        arrayIndex->print(nextPrefix);
-        expression->print(nextPrefix);
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(arrayIndex->generateJson());
-        root["children"].append(expression->generateJson());
-        return root;
+        return ASTKind::ArrayAssignment;
     }
 
     llvm::Value *generateCode(CodeGenContext &context) override;
@@ -875,35 +591,14 @@ public:
             : declaration(dec), expressionList(list)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_ArrayInitialization";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << (isGlobal ? "[global]" : "") << std::endl;
-        declaration->print(nextPrefix);
-
-        for (auto it = expressionList->begin(); it != expressionList->end(); it++)
-        {
-            (*it)->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(declaration->generateJson());
-
-        for (auto it = expressionList->begin(); it != expressionList->end(); it++)
-        {
-            root["children"].append((*it)->generateJson());
-        }
-
-        return root;
+        return ASTKind::ArrayInitialization;
     }
 
     llvm::Value *generateCode(CodeGenContext &context) override;
@@ -916,6 +611,8 @@ public:
     shared_ptr<AST_Identifier> member;
     shared_ptr<AST_ArrayIndex> array;
     bool isArray;
+    // Set by the semantic analysis, -1 if the struct has no such member.
+    long memberIndex = -1;
 
     AST_StructMember()
     {}
@@ -925,34 +622,14 @@ public:
             : id(structName), member(member), array(array), isArray(isArray)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_StructMember";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        id->print(nextPrefix);
-        member->print(nextPrefix);
-        if (isArray)
-        {
-            array->print(nextPrefix);
-        }
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(id->generateJson());
-        root["children"].append(member->generateJson());
-        if (isArray)
-        {
-            root["children"].append(array->generateJson());
-        }
-        return root;
+        return ASTKind::StructMember;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -971,26 +648,14 @@ public:
             : structMember(member), expression(exp)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_StructAssignment";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::string nextPrefix = prefix + this->PREFIX;
-        std::cout << prefix << getTypeName() << DELIMINATER << std::endl;
-        structMember->print(nextPrefix);
-        expression->print(nextPrefix);
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName();
-        root["children"].append(structMember->generateJson());
-        root["children"].append(expression->generateJson());
-        return root;
+        return ASTKind::StructAssignment;
     }
 
     llvm::Value *generateCode(CodeGenContext &context) override;
@@ -1007,21 +672,14 @@ public:
             value(str)
     {}
 
-    std::string getTypeName() const override
+    const char *getTypeName() const override
     {
         return "AST_Literal";
     }
 
-    void print(std::string prefix) const override
-    {
-        std::cout << prefix << getTypeName() << DELIMINATER << value << std::endl;
-    }
-
-    Json::Value generateJson() const override
+    ASTKind getKind() const override
     {
-        Json::Value root;
-        root["name"] = getTypeName() + DELIMINATER + value;
-        return root;
+        return ASTKind::Literal;
     }
 
     virtual llvm::Value *generateCode(CodeGenContext &context) override;
@@ -0,0 +1,858 @@
+#include <cstring>
+#include <unordered_map>
+#include "ast_binary.h"
+#include "diagnostics.h"
+
+static const char Magic[8] = {'S', 'L', 'A', 'N', 'G', 'A', 'S', 'T'};
+static const uint32_t Version = 1;
+static const size_t HeaderSize = 8 + 4 + 4 + 3 * 8;
+
+// Flags of the nodes that have any.
+static const uint64_t FlagIsGlobal = 1;
+static const uint64_t FlagAtLeastOnce = 2;
+static const uint64_t FlagIsType = 4;
+static const uint64_t FlagIsArray = 8;
+static const uint64_t FlagIsExternal = 16;
+
+// Deepest nesting of nodes read, so that crafted input can't overflow the stack.
+static const unsigned MaxDepth = 4096;
+
+static void appendFixed(std::string &out, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; i++)
+    {
+        out.push_back((char) (value >> (8 * i)));
+    }
+}
+
+static uint64_t readFixed(const char *data, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; i++)
+    {
+        value |= (uint64_t) (unsigned char) data[i] << (8 * i);
+    }
+    return value;
+}
+
+static void appendVarint(std::string &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((char) (value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char) value);
+}
+
+/*
+ * ASTWriter: encodes nodes into a buffer and interns their strings.
+ */
+class ASTWriter
+{
+public:
+    std::string nodes;
+    std::vector<const std::string *> strings;
+
+    void writeNode(const AST_Node *node);
+
+private:
+    void writeSigned(int value)
+    {
+        appendVarint(nodes, ((uint64_t) (int64_t) value << 1) ^ (uint64_t) ((int64_t) value >> 63));
+    }
+
+    void writeString(const std::string &value)
+    {
+        auto inserted = stringIndex.insert(std::make_pair(value, (uint64_t) strings.size()));
+        if (inserted.second)
+        {
+            strings.push_back(&inserted.first->first);
+        }
+        appendVarint(nodes, inserted.first->second);
+    }
+
+    template<typename T>
+    void writeList(const std::shared_ptr<std::vector<std::shared_ptr<T>>> &list)
+    {
+        if (!list)
+        {
+            appendVarint(nodes, 0);
+            return;
+        }
+        appendVarint(nodes, list->size() + 1);
+        for (auto &element : *list)
+        {
+            writeNode(element.get());
+        }
+    }
+
+    uint64_t statementFlags(const AST_Statement *statement)
+    {
+        return (statement->isGlobal ? FlagIsGlobal : 0) | (statement->atLeastOnce ? FlagAtLeastOnce : 0);
+    }
+
+    std::unordered_map<std::string, uint64_t> stringIndex;
+};
+
+void ASTWriter::writeNode(const AST_Node *node)
+{
+    if (!node)
+    {
+        nodes.push_back(0);
+        return;
+    }
+    nodes.push_back((char) node->getKind());
+    writeSigned(node->row);
+    writeSigned(node->col);
+    switch (node->getKind())
+    {
+        case ASTKind::Expression:
+            break;
+        case ASTKind::Statement:
+            appendVarint(nodes, statementFlags(static_cast<const AST_Statement *>(node)));
+            break;
+        case ASTKind::Double:
+        {
+            double value = static_cast<const AST_Double *>(node)->value;
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            appendFixed(nodes, bits, 8);
+            break;
+        }
+        case ASTKind::Integer:
+            appendVarint(nodes, static_cast<const AST_Integer *>(node)->value);
+            break;
+        case ASTKind::Identifier:
+        {
+            auto identifier = static_cast<const AST_Identifier *>(node);
+            writeString(identifier->name);
+            appendVarint(nodes, (identifier->isType ? FlagIsType : 0) | (identifier->isArray ? FlagIsArray : 0));
+            writeList(identifier->arraySize);
+            break;
+        }
+        case ASTKind::MethodCall:
+        {
+            auto call = static_cast<const AST_MethodCall *>(node);
+            writeNode(call->id.get());
+            writeList(call->arguments);
+            break;
+        }
+        case ASTKind::BinaryOperator:
+        {
+            auto binary = static_cast<const AST_BinaryOperator *>(node);
+            writeSigned(binary->op);
+            writeNode(binary->lhs.get());
+            writeNode(binary->rhs.get());
+            break;
+        }
+        case ASTKind::Assignment:
+        {
+            auto assignment = static_cast<const AST_Assignment *>(node);
+            writeNode(assignment->lhs.get());
+            writeNode(assignment->rhs.get());
+            break;
+        }
+        case ASTKind::Block:
+            writeList(static_cast<const AST_Block *>(node)->statements);
+            break;
+        case ASTKind::ExpressionStatement:
+        {
+            auto statement = static_cast<const AST_ExpressionStatement *>(node);
+            appendVarint(nodes, statementFlags(statement));
+            writeNode(statement->expression.get());
+            break;
+        }
+        case ASTKind::VariableDeclaration:
+        {
+            auto declaration = static_cast<const AST_VariableDeclaration *>(node);
+            appendVarint(nodes, statementFlags(declaration));
+            writeNode(declaration->type.get());
+            writeNode(declaration->id.get());
+            writeNode(declaration->assignmentExpr.get());
+            break;
+        }
+        case ASTKind::FunctionDeclaration:
+        {
+            auto function = static_cast<const AST_FunctionDeclaration *>(node);
+            appendVarint(nodes, statementFlags(function) | (function->isExternal ? FlagIsExternal : 0));
+            writeNode(function->type.get());
+            writeNode(function->id.get());
+            writeList(function->arguments);
+            writeNode(function->block.get());
+            break;
+        }
+        case ASTKind::StructDeclaration:
+        {
+            auto structure = static_cast<const AST_StructDeclaration *>(node);
+            appendVarint(nodes, statementFlags(structure));
+            writeNode(structure->name.get());
+            writeList(structure->members);
+            break;
+        }
+        case ASTKind::ReturnStatement:
+        {
+            auto statement = static_cast<const AST_ReturnStatement *>(node);
+            appendVarint(nodes, statementFlags(statement));
+            writeNode(statement->expression.get());
+            break;
+        }
+        case ASTKind::IfStatement:
+        {
+            auto statement = static_cast<const AST_IfStatement *>(node);
+            appendVarint(nodes, statementFlags(statement));
+            writeNode(statement->condition.get());
+            writeNode(statement->trueBlock.get());
+            writeNode(statement->falseBlock.get());
+            break;
+        }
+        case ASTKind::ForStatement:
+        {
+            auto statement = static_cast<const AST_ForStatement *>(node);
+            appendVarint(nodes, statementFlags(statement));
+            writeNode(statement->initial.get());
+            writeNode(statement->condition.get());
+            writeNode(statement->increment.get());
+            writeNode(statement->block.get());
+            break;
+        }
+        case ASTKind::ArrayIndex:
+        {
+            auto index = static_cast<const AST_ArrayIndex *>(node);
+            writeNode(index->arrayName.get());
+            writeList(index->expressions);
+            break;
+        }
+        case ASTKind::ArrayAssignment:
+        {
+            auto assignment = static_cast<const AST_ArrayAssignment *>(node);
+            writeNode(assignment->arrayIndex.get());
+            writeNode(assignment->expression.get());
+            break;
+        }
+        case ASTKind::ArrayInitialization:
+        {
+            auto initialization = static_cast<const AST_ArrayInitialization *>(node);
+            appendVarint(nodes, statementFlags(initialization));
+            writeNode(initialization->declaration.get());
+            writeList(initialization->expressionList);
+            break;
+        }
+        case ASTKind::StructMember:
+        {
+            auto member = static_cast<const AST_StructMember *>(node);
+            appendVarint(nodes, member->isArray ? FlagIsArray : 0);
+            writeNode(member->id.get());
+            writeNode(member->member.get());
+            writeNode(member->array.get());
+            break;
+        }
+        case ASTKind::StructAssignment:
+        {
+            auto assignment = static_cast<const AST_StructAssignment *>(node);
+            writeNode(assignment->structMember.get());
+            writeNode(assignment->expression.get());
+            break;
+        }
+        case ASTKind::Literal:
+            writeString(static_cast<const AST_Literal *>(node)->value);
+            break;
+    }
+}
+
+std::string writeASTBinary(const std::shared_ptr<AST_Block> &programBlock)
+{
+    ASTWriter writer;
+    std::string directory;
+    uint64_t count = programBlock ? programBlock->statements->size() : 0;
+    appendVarint(directory, count);
+    for (uint64_t i = 0; i < count; i++)
+    {
+        size_t start = writer.nodes.size();
+        writer.writeNode((*programBlock->statements)[i].get());
+        appendVarint(directory, writer.nodes.size() - start);
+    }
+
+    std::string strings;
+    appendVarint(strings, writer.strings.size());
+    for (auto string : writer.strings)
+    {
+        appendVarint(strings, string->size());
+        strings += *string;
+    }
+
+    std::string out;
+    out.reserve(HeaderSize + strings.size() + directory.size() + writer.nodes.size());
+    out.append(Magic, sizeof(Magic));
+    appendFixed(out, Version, 4);
+    appendFixed(out, count, 4);
+    appendFixed(out, HeaderSize, 8);
+    appendFixed(out, HeaderSize + strings.size(), 8);
+    appendFixed(out, HeaderSize + strings.size() + directory.size(), 8);
+    out += strings;
+    out += directory;
+    out += writer.nodes;
+    return out;
+}
+
+bool isASTBinary(const char *data, size_t size)
+{
+    return size >= sizeof(Magic) && memcmp(data, Magic, sizeof(Magic)) == 0;
+}
+
+ASTReader::ASTReader(const char *data, size_t size) :
+        data(data),
+        size(size),
+        position(data),
+        end(data + size),
+        depth(0),
+        failed(false)
+{
+    if (size < HeaderSize || !isASTBinary(data, size))
+    {
+        fail("not an AST file");
+        return;
+    }
+    if (readFixed(data + 8, 4) != Version)
+    {
+        fail("unsupported AST file version");
+        return;
+    }
+    uint64_t count = readFixed(data + 12, 4);
+    uint64_t stringsOffset = readFixed(data + 16, 8);
+    uint64_t directoryOffset = readFixed(data + 24, 8);
+    uint64_t nodesOffset = readFixed(data + 32, 8);
+    if (stringsOffset > directoryOffset || directoryOffset > nodesOffset || nodesOffset > size)
+    {
+        fail("bad section offsets");
+        return;
+    }
+
+    position = data + stringsOffset;
+    end = data + directoryOffset;
+    uint64_t stringCount;
+    if (!readVarint(stringCount) || stringCount > (uint64_t) (end - position))
+    {
+        fail("bad string table");
+        return;
+    }
+    strings.reserve(stringCount);
+    for (uint64_t i = 0; i < stringCount; i++)
+    {
+        uint64_t length;
+        if (!readVarint(length) || length > (uint64_t) (end - position))
+        {
+            fail("bad string table");
+            return;
+        }
+        strings.push_back(std::make_pair(position, (size_t) length));
+        position += length;
+    }
+
+    // Statement i starts where statement i - 1 ends.
+    end = data + nodesOffset;
+    uint64_t directoryCount;
+    if (!readVarint(directoryCount) || directoryCount != count)
+    {
+        fail("bad directory");
+        return;
+    }
+    const char *statement = data + nodesOffset;
+    statements.reserve(count);
+    for (uint64_t i = 0; i < count; i++)
+    {
+        uint64_t length;
+        if (!readVarint(length) || length > (uint64_t) (data + size - statement))
+        {
+            fail("bad directory");
+            return;
+        }
+        statements.push_back(std::make_pair(statement, (size_t) length));
+        statement += length;
+    }
+}
+
+bool ASTReader::fail(const char *what)
+{
+    if (!failed)
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m cannot read AST: %s\n", what);
+        failed = true;
+    }
+    return false;
+}
+
+bool ASTReader::readVarint(uint64_t &value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (position == end)
+        {
+            return fail("truncated data");
+        }
+        unsigned char byte = (unsigned char) *position++;
+        value |= (uint64_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return fail("bad varint");
+}
+
+bool ASTReader::readSigned(int &value)
+{
+    uint64_t encoded;
+    if (!readVarint(encoded))
+    {
+        return false;
+    }
+    value = (int) (int64_t) ((encoded >> 1) ^ -(encoded & 1));
+    return true;
+}
+
+bool ASTReader::readString(std::string &value)
+{
+    uint64_t index;
+    if (!readVarint(index))
+    {
+        return false;
+    }
+    if (index >= strings.size())
+    {
+        return fail("bad string index");
+    }
+    value.assign(strings[index].first, strings[index].second);
+    return true;
+}
+
+template<typename T>
+bool ASTReader::readChild(std::shared_ptr<T> &child, bool optional)
+{
+    std::shared_ptr<AST_Node> node;
+    if (!readNode(node))
+    {
+        return false;
+    }
+    if (!node)
+    {
+        return optional || fail("missing child");
+    }
+    child = std::dynamic_pointer_cast<T>(node);
+    return child || fail("child of the wrong kind");
+}
+
+template<typename T>
+bool ASTReader::readList(std::shared_ptr<std::vector<std::shared_ptr<T>>> &list, bool optional)
+{
+    uint64_t count;
+    if (!readVarint(count))
+    {
+        return false;
+    }
+    if (count == 0)
+    {
+        // Only the array sizes of an identifier and the arguments of a call may be left out.
+        list = nullptr;
+        return optional || fail("missing list");
+    }
+    // Every element takes at least a byte.
+    if (count - 1 > (uint64_t) (end - position))
+    {
+        return fail("bad list size");
+    }
+    list = std::make_shared<std::vector<std::shared_ptr<T>>>();
+    list->reserve(count - 1);
+    for (uint64_t i = 1; i < count; i++)
+    {
+        std::shared_ptr<T> element;
+        if (!readChild(element))
+        {
+            return false;
+        }
+        list->push_back(element);
+    }
+    return true;
+}
+
+bool ASTReader::readNode(std::shared_ptr<AST_Node> &node)
+{
+    if (depth == MaxDepth)
+    {
+        return fail("nesting too deep");
+    }
+    depth++;
+    bool read = readNodeFields(node);
+    depth--;
+    return read;
+}
+
+bool ASTReader::readNodeFields(std::shared_ptr<AST_Node> &node)
+{
+    if (position == end)
+    {
+        return fail("truncated data");
+    }
+    auto kind = (ASTKind) *position++;
+    if ((unsigned) kind == 0)
+    {
+        node = nullptr;
+        return true;
+    }
+    int row, col;
+    if (!readSigned(row) || !readSigned(col))
+    {
+        return false;
+    }
+
+    uint64_t flags = 0;
+    bool isStatement = false;
+    switch (kind)
+    {
+        case ASTKind::Statement:
+        case ASTKind::ExpressionStatement:
+        case ASTKind::VariableDeclaration:
+        case ASTKind::FunctionDeclaration:
+        case ASTKind::StructDeclaration:
+        case ASTKind::ReturnStatement:
+        case ASTKind::IfStatement:
+        case ASTKind::ForStatement:
+        case ASTKind::ArrayInitialization:
+            isStatement = true;
+            // Fall through.
+        case ASTKind::StructMember:
+            if (!readVarint(flags))
+            {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+
+    switch (kind)
+    {
+        case ASTKind::Expression:
+            node = std::make_shared<AST_Expression>();
+            break;
+        case ASTKind::Statement:
+            node = std::make_shared<AST_Statement>();
+            break;
+        case ASTKind::Double:
+        {
+            if (end - position < 8)
+            {
+                return fail("truncated data");
+            }
+            uint64_t bits = readFixed(position, 8);
+            position += 8;
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            node = std::make_shared<AST_Double>(value);
+            break;
+        }
+        case ASTKind::Integer:
+        {
+            uint64_t value;
+            if (!readVarint(value))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_Integer>(value);
+            break;
+        }
+        case ASTKind::Identifier:
+        {
+            std::string name;
+            uint64_t identifierFlags;
+            if (!readString(name) || !readVarint(identifierFlags))
+            {
+                return false;
+            }
+            auto identifier = std::make_shared<AST_Identifier>(name);
+            identifier->isType = (identifierFlags & FlagIsType) != 0;
+            identifier->isArray = (identifierFlags & FlagIsArray) != 0;
+            if (!readList(identifier->arraySize, true))
+            {
+                return false;
+            }
+            if (identifier->isArray)
+            {
+                // The parser gives an array type one constant per dimension.
+                if (!identifier->arraySize || identifier->arraySize->empty())
+                {
+                    return fail("array type without dimensions");
+                }
+                for (auto &size : *identifier->arraySize)
+                {
+                    if (size->getKind() != ASTKind::Integer)
+                    {
+                        return fail("array dimension is not a constant");
+                    }
+                }
+            }
+            node = identifier;
+            break;
+        }
+        case ASTKind::MethodCall:
+        {
+            std::shared_ptr<AST_Identifier> id;
+            std::shared_ptr<AST_ExpressionList> arguments;
+            if (!readChild(id) || !readList(arguments, true))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_MethodCall>(id, arguments);
+            break;
+        }
+        case ASTKind::BinaryOperator:
+        {
+            int op;
+            std::shared_ptr<AST_Expression> lhs, rhs;
+            if (!readSigned(op) || !readChild(lhs) || !readChild(rhs))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_BinaryOperator>(lhs, op, rhs);
+            break;
+        }
+        case ASTKind::Assignment:
+        {
+            std::shared_ptr<AST_Identifier> lhs;
+            std::shared_ptr<AST_Expression> rhs;
+            if (!readChild(lhs) || !readChild(rhs))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_Assignment>(lhs, rhs);
+            break;
+        }
+        case ASTKind::Block:
+        {
+            auto block = std::make_shared<AST_Block>();
+            if (!readList(block->statements))
+            {
+                return false;
+            }
+            node = block;
+            break;
+        }
+        case ASTKind::ExpressionStatement:
+        {
+            std::shared_ptr<AST_Expression> expression;
+            if (!readChild(expression))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_ExpressionStatement>(expression);
+            break;
+        }
+        case ASTKind::VariableDeclaration:
+        {
+            std::shared_ptr<AST_Identifier> type, id;
+            std::shared_ptr<AST_Expression> assignmentExpr;
+            if (!readChild(type) || !readChild(id) || !readChild(assignmentExpr, true))
+            {
+                return false;
+            }
+            if (!type->isType)
+            {
+                return fail("declaration without a type");
+            }
+            node = std::make_shared<AST_VariableDeclaration>(type, id, assignmentExpr);
+            break;
+        }
+        case ASTKind::FunctionDeclaration:
+        {
+            std::shared_ptr<AST_Identifier> type, id;
+            std::shared_ptr<AST_VariableList> arguments;
+            std::shared_ptr<AST_Block> block;
+            if (!readChild(type) || !readChild(id) || !readList(arguments) || !readChild(block, true))
+            {
+                return false;
+            }
+            if (!type->isType)
+            {
+                return fail("declaration without a type");
+            }
+            if (!block && !(flags & FlagIsExternal))
+            {
+                return fail("function definition without a body");
+            }
+            node = std::make_shared<AST_FunctionDeclaration>(type, id, arguments, block,
+                                                             (flags & FlagIsExternal) != 0);
+            break;
+        }
+        case ASTKind::StructDeclaration:
+        {
+            std::shared_ptr<AST_Identifier> name;
+            std::shared_ptr<AST_VariableList> members;
+            if (!readChild(name) || !readList(members))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_StructDeclaration>(name, members);
+            break;
+        }
+        case ASTKind::ReturnStatement:
+        {
+            std::shared_ptr<AST_Expression> expression;
+            if (!readChild(expression))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_ReturnStatement>(expression);
+            break;
+        }
+        case ASTKind::IfStatement:
+        {
+            std::shared_ptr<AST_Expression> condition;
+            std::shared_ptr<AST_Block> trueBlock, falseBlock;
+            if (!readChild(condition) || !readChild(trueBlock) || !readChild(falseBlock, true))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_IfStatement>(condition, trueBlock, falseBlock);
+            break;
+        }
+        case ASTKind::ForStatement:
+        {
+            std::shared_ptr<AST_Expression> initial, condition, increment;
+            std::shared_ptr<AST_Block> block;
+            if (!readChild(initial, true) || !readChild(condition) || !readChild(increment, true) ||
+                !readChild(block))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_ForStatement>(block, initial, condition, increment);
+            break;
+        }
+        case ASTKind::ArrayIndex:
+        {
+            std::shared_ptr<AST_Identifier> arrayName;
+            std::shared_ptr<AST_ExpressionList> expressions;
+            if (!readChild(arrayName) || !readList(expressions))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_ArrayIndex>(arrayName, expressions);
+            break;
+        }
+        case ASTKind::ArrayAssignment:
+        {
+            std::shared_ptr<AST_ArrayIndex> arrayIndex;
+            std::shared_ptr<AST_Expression> expression;
+            if (!readChild(arrayIndex) || !readChild(expression))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_ArrayAssignment>(arrayIndex, expression);
+            break;
+        }
+        case ASTKind::ArrayInitialization:
+        {
+            std::shared_ptr<AST_VariableDeclaration> declaration;
+            std::shared_ptr<AST_ExpressionList> expressionList;
+            if (!readChild(declaration) || !readList(expressionList))
+            {
+                return false;
+            }
+            if (!declaration->type->isArray)
+            {
+                return fail("array initializer of a scalar");
+            }
+            node = std::make_shared<AST_ArrayInitialization>(declaration, expressionList);
+            break;
+        }
+        case ASTKind::StructMember:
+        {
+            std::shared_ptr<AST_Identifier> id, member;
+            std::shared_ptr<AST_ArrayIndex> array;
+            if (!readChild(id) || !readChild(member) || !readChild(array, true))
+            {
+                return false;
+            }
+            if (!array && (flags & FlagIsArray))
+            {
+                return fail("member of an array element without the element");
+            }
+            node = std::make_shared<AST_StructMember>(id, member, array, (flags & FlagIsArray) != 0);
+            break;
+        }
+        case ASTKind::StructAssignment:
+        {
+            std::shared_ptr<AST_StructMember> structMember;
+            std::shared_ptr<AST_Expression> expression;
+            if (!readChild(structMember) || !readChild(expression))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_StructAssignment>(structMember, expression);
+            break;
+        }
+        case ASTKind::Literal:
+        {
+            std::string value;
+            if (!readString(value))
+            {
+                return false;
+            }
+            node = std::make_shared<AST_Literal>(value);
+            break;
+        }
+        default:
+            return fail("unknown node kind");
+    }
+
+    node->row = row;
+    node->col = col;
+    if (isStatement)
+    {
+        auto statement = static_cast<AST_Statement *>(node.get());
+        statement->isGlobal = (flags & FlagIsGlobal) != 0;
+        statement->atLeastOnce = (flags & FlagAtLeastOnce) != 0;
+    }
+    return true;
+}
+
+std::shared_ptr<AST_Statement> ASTReader::readStatement(size_t index)
+{
+    if (failed || index >= statements.size())
+    {
+        return nullptr;
+    }
+    position = statements[index].first;
+    end = position + statements[index].second;
+    std::shared_ptr<AST_Statement> statement;
+    if (!readChild(statement))
+    {
+        return nullptr;
+    }
+    if (position != end)
+    {
+        fail("statement size mismatch");
+        return nullptr;
+    }
+    return statement;
+}
+
+std::shared_ptr<AST_Block> ASTReader::readProgram()
+{
+    if (failed)
+    {
+        return nullptr;
+    }
+    auto block = std::make_shared<AST_Block>();
+    block->statements->reserve(statements.size());
+    for (size_t i = 0; i < statements.size(); i++)
+    {
+        auto statement = readStatement(i);
+        if (!statement)
+        {
+            return nullptr;
+        }
+        block->statements->push_back(statement);
+    }
+    return block;
+}
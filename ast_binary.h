@@ -0,0 +1,104 @@
+#ifndef SLANG_AST_BINARY_H
+#define SLANG_AST_BINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "absyn.h"
+
+/*
+ * The -emit-ast format, all integers little-endian:
+ *
+ *     header      "SLANGAST", u32 version, u32 statement count,
+ *                 u64 offsets of the string table, the directory and the nodes
+ *     strings     varint count, then varint length and bytes of every string
+ *     directory   varint size in bytes of every top-level statement
+ *     nodes       the top-level statements, one after the other
+ *
+ * A node is its ASTKind tag, zigzag varint row and col, then the fields of
+ * its class and its children in the order of the class's members. Names are
+ * varint indices into the string table, absent children are a 0 tag and
+ * lists are their varint size + 1, 0 for no list. The header has fixed
+ * offsets and nothing points outside the file, so it can be read in place
+ * from an mmap'd file, and the directory lets a reader pick out single
+ * top-level declarations.
+ */
+
+/*
+ * writeASTBinary: serialize an AST.
+ * @param programBlock -- nullptr for an empty file.
+ */
+std::string writeASTBinary(const std::shared_ptr<AST_Block> &programBlock);
+
+/*
+ * isASTBinary: whether data starts like a -emit-ast file.
+ */
+bool isASTBinary(const char *data, size_t size);
+
+/*
+ * ASTReader: rebuilds the AST from the -emit-ast format without the scanner
+ * and parser. The data must outlive the reader, but not the nodes it returns.
+ * Malformed data is reported as a diagnostic once, and nullptr returned.
+ */
+class ASTReader
+{
+public:
+    ASTReader(const char *data, size_t size);
+
+    /*
+     * valid: whether the header, string table and directory could be read.
+     */
+    bool valid() const
+    {
+        return !failed;
+    }
+
+    size_t getStatementCount() const
+    {
+        return statements.size();
+    }
+
+    /*
+     * readStatement: the top-level statement at index, read on its own.
+     */
+    std::shared_ptr<AST_Statement> readStatement(size_t index);
+
+    /*
+     * readProgram: the whole AST, an empty block for an empty file.
+     */
+    std::shared_ptr<AST_Block> readProgram();
+
+private:
+    bool fail(const char *what);
+
+    bool readVarint(uint64_t &value);
+
+    bool readSigned(int &value);
+
+    bool readString(std::string &value);
+
+    bool readNode(std::shared_ptr<AST_Node> &node);
+
+    bool readNodeFields(std::shared_ptr<AST_Node> &node);
+
+    template<typename T>
+    bool readChild(std::shared_ptr<T> &child, bool optional = false);
+
+    template<typename T>
+    bool readList(std::shared_ptr<std::vector<std::shared_ptr<T>>> &list, bool optional = false);
+
+    const char *data;
+    size_t size;
+    // Read position while decoding, and the end of the current statement.
+    const char *position;
+    const char *end;
+    // Nodes being read, see MaxDepth.
+    unsigned depth;
+    std::vector<std::pair<const char *, size_t>> strings;
+    std::vector<std::pair<const char *, size_t>> statements;
+    bool failed;
+};
+
+#endif //SLANG_AST_BINARY_H
@@ -0,0 +1,210 @@
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include <sys/stat.h>
+#include "ast_export.h"
+#include "diagnostics.h"
+#include "json_writer.h"
+#include "time_report.h"
+
+// Declarations are packed into chunks up to this size, larger ones get a chunk of their own.
+static const uint64_t ChunkBytes = 256 * 1024;
+
+static bool reportWriteError(const std::string &file)
+{
+    reportDiagnostic("slang:\033[1;31m error:\033[0m cannot write '%s': %s\n", file.c_str(), strerror(errno));
+    return false;
+}
+
+bool dumpASTJson(const std::shared_ptr<AST_Block> &programBlock, const std::string &file)
+{
+    TimeRegion region("AST JSON export");
+    std::ofstream os(file, std::ios::binary);
+    if (!os.is_open())
+    {
+        return reportWriteError(file);
+    }
+
+    // An empty file has no AST, write an empty block.
+    AST_Block empty;
+    JsonWriter writer(os);
+    (programBlock ? *programBlock : empty).writeJson(writer);
+    if (!writer.flush())
+    {
+        return reportWriteError(file);
+    }
+    return true;
+}
+
+/*
+ * IndexEntry: a top-level declaration as listed by index.js.
+ */
+struct IndexEntry
+{
+    const char *kind;
+    std::string label;
+    unsigned chunk;
+    unsigned slot;
+    uint64_t bytes;
+};
+
+static IndexEntry describe(const AST_Statement &statement)
+{
+    IndexEntry entry = {"statement", statement.getTypeName(), 0, 0, 0};
+    if (auto function = dynamic_cast<const AST_FunctionDeclaration *>(&statement))
+    {
+        entry.kind = "function";
+        entry.label = function->id->name;
+    } else if (auto structure = dynamic_cast<const AST_StructDeclaration *>(&statement))
+    {
+        entry.kind = "struct";
+        entry.label = structure->name->name;
+    } else if (auto array = dynamic_cast<const AST_ArrayInitialization *>(&statement))
+    {
+        entry.kind = "variable";
+        entry.label = array->declaration->id->name;
+    } else if (auto variable = dynamic_cast<const AST_VariableDeclaration *>(&statement))
+    {
+        entry.kind = "variable";
+        entry.label = variable->id->name;
+    }
+    return entry;
+}
+
+/*
+ * Chunk: the chunk-<n>.js being written.
+ */
+class Chunk
+{
+public:
+    Chunk(const std::string &dir, unsigned number) :
+            file(dir + "/chunk-" + std::to_string(number) + ".js"),
+            os(file, std::ios::binary),
+            bytes(0),
+            slots(0)
+    {
+        os << "slangAST.chunk(" << number << ",[";
+    }
+
+    /*
+     * add: append the JSON of a subtree.
+     * @return its slot.
+     */
+    unsigned add(const std::string &json)
+    {
+        if (slots > 0)
+        {
+            os << ",";
+        }
+        os << json;
+        bytes += json.size();
+        return slots++;
+    }
+
+    /*
+     * fits: whether a subtree of the given size still goes into this chunk.
+     */
+    bool fits(uint64_t size) const
+    {
+        return bytes + size <= ChunkBytes;
+    }
+
+    bool close()
+    {
+        os << "]);\n";
+        os.close();
+        if (!os)
+        {
+            return reportWriteError(file);
+        }
+        return true;
+    }
+
+private:
+    std::string file;
+    std::ofstream os;
+    uint64_t bytes;
+    unsigned slots;
+};
+
+bool dumpASTChunks(const std::shared_ptr<AST_Block> &programBlock, const std::string &dir,
+                   const std::string &source)
+{
+    TimeRegion region("AST JSON export");
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m cannot create directory '%s': %s\n", dir.c_str(),
+                         strerror(errno));
+        return false;
+    }
+
+    std::vector<IndexEntry> entries;
+    unsigned chunks = 0;
+    if (programBlock)
+    {
+        std::unique_ptr<Chunk> chunk;
+        std::ostringstream subtree;
+        for (auto &statement : *programBlock->statements)
+        {
+            // One subtree at a time is held in memory, to see whether it fits into the current chunk.
+            subtree.str(std::string());
+            {
+                JsonWriter writer(subtree);
+                statement->writeJson(writer);
+            }
+            std::string json = subtree.str();
+            if (chunk && !chunk->fits(json.size()))
+            {
+                if (!chunk->close())
+                {
+                    return false;
+                }
+                chunk = nullptr;
+            }
+            if (!chunk)
+            {
+                chunk.reset(new Chunk(dir, chunks++));
+            }
+
+            IndexEntry entry = describe(*statement);
+            entry.chunk = chunks - 1;
+            entry.slot = chunk->add(json);
+            entry.bytes = json.size();
+            entries.push_back(entry);
+        }
+        if (chunk && !chunk->close())
+        {
+            return false;
+        }
+    }
+
+    std::string file = dir + "/index.js";
+    std::ofstream os(file, std::ios::binary);
+    if (!os.is_open())
+    {
+        return reportWriteError(file);
+    }
+    JsonWriter writer(os);
+    writer.writeRaw("slangAST.index({\"source\":");
+    writer.writeString(source);
+    writer.writeRaw((",\"chunks\":" + std::to_string(chunks) + ",\"entries\":[\n").c_str());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const IndexEntry &entry = entries[i];
+        writer.writeRaw(i > 0 ? ",\n{\"kind\":\"" : "{\"kind\":\"");
+        writer.writeRaw(entry.kind);
+        writer.writeRaw("\",\"label\":");
+        writer.writeString(entry.label);
+        writer.writeRaw((",\"chunk\":" + std::to_string(entry.chunk) + ",\"slot\":" + std::to_string(entry.slot) +
+                         ",\"bytes\":" + std::to_string(entry.bytes) + "}").c_str());
+    }
+    writer.writeRaw("\n]});\n");
+    if (!writer.flush())
+    {
+        return reportWriteError(file);
+    }
+    return true;
+}
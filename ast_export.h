@@ -0,0 +1,27 @@
+#ifndef SLANG_AST_EXPORT_H
+#define SLANG_AST_EXPORT_H
+
+#include <memory>
+#include <string>
+#include "absyn.h"
+
+/*
+ * dumpASTJson: write the AST of -dump-ast-json to file as one JSON tree.
+ * @param programBlock -- nullptr for an empty file.
+ * @return false if the file can't be written, it has been reported.
+ */
+bool dumpASTJson(const std::shared_ptr<AST_Block> &programBlock, const std::string &file);
+
+/*
+ * dumpASTChunks: write the AST of -dump-ast-dir to dir for visualization/AST.html.
+ * index.js lists the top-level declarations, and chunk-<n>.js hold their
+ * subtrees, several small declarations to a chunk, so that the viewer only
+ * loads what is expanded. Both are JavaScript calls rather than plain JSON
+ * so that the viewer can load them with script tags from a local file.
+ * @param source -- input name shown by the viewer.
+ * @return false if a file can't be written, it has been reported.
+ */
+bool dumpASTChunks(const std::shared_ptr<AST_Block> &programBlock, const std::string &dir,
+                   const std::string &source);
+
+#endif //SLANG_AST_EXPORT_H
@@ -0,0 +1,144 @@
+#include <cstring>
+#include <iostream>
+#include "ast_visitor.h"
+
+namespace
+{
+
+const char *const Delimiter = ":";
+const char *const Indent = "--";
+
+/*
+ * ASTPrinter: -dump-ast, the type name and the attributes of a node on a line,
+ * its children below it, indented by one more Indent.
+ */
+class ASTPrinter : public ASTVisitor<ASTPrinter>
+{
+public:
+    explicit ASTPrinter(const std::string &prefix) : prefix(prefix)
+    {}
+
+    void enter(const AST_Node &node)
+    {
+        std::cout << prefix << node.getTypeName();
+        switch (node.getKind())
+        {
+            case ASTKind::Expression:
+            case ASTKind::Statement:
+                break;
+            case ASTKind::Double:
+                std::cout << Delimiter << static_cast<const AST_Double &>(node).value;
+                break;
+            case ASTKind::Integer:
+                std::cout << Delimiter << static_cast<const AST_Integer &>(node).value;
+                break;
+            case ASTKind::Identifier:
+            {
+                auto &identifier = static_cast<const AST_Identifier &>(node);
+                std::cout << Delimiter << identifier.name << (identifier.isArray ? "(Array)" : "");
+                break;
+            }
+            case ASTKind::BinaryOperator:
+                std::cout << Delimiter << static_cast<const AST_BinaryOperator &>(node).op;
+                break;
+            case ASTKind::VariableDeclaration:
+            case ASTKind::ArrayInitialization:
+                std::cout << Delimiter << (static_cast<const AST_Statement &>(node).isGlobal ? "[global]" : "");
+                break;
+            case ASTKind::StructDeclaration:
+                std::cout << Delimiter << static_cast<const AST_StructDeclaration &>(node).name->name;
+                break;
+            case ASTKind::Literal:
+                std::cout << Delimiter << static_cast<const AST_Literal &>(node).value;
+                break;
+            default:
+                std::cout << Delimiter;
+                break;
+        }
+        std::cout << std::endl;
+        prefix += Indent;
+    }
+
+    void leave(const AST_Node &)
+    {
+        prefix.resize(prefix.size() - strlen(Indent));
+    }
+
+private:
+    std::string prefix;
+};
+
+/*
+ * JsonVisitor: -dump-ast-json, a node is open from enter to leave so that its
+ * children nest in it.
+ */
+class JsonVisitor : public ASTVisitor<JsonVisitor>
+{
+public:
+    explicit JsonVisitor(JsonWriter &writer) : writer(writer)
+    {}
+
+    void enter(const AST_Node &node)
+    {
+        writer.beginNode(node.getTypeName());
+        switch (node.getKind())
+        {
+            case ASTKind::Statement:
+                writer.appendName(Delimiter);
+                writer.appendName(static_cast<const AST_Statement &>(node).isGlobal ? "global" : "");
+                break;
+            case ASTKind::Double:
+                writer.appendName(Delimiter);
+                writer.appendName(static_cast<const AST_Double &>(node).value);
+                break;
+            case ASTKind::Integer:
+                writer.appendName(Delimiter);
+                writer.appendName(static_cast<const AST_Integer &>(node).value);
+                break;
+            case ASTKind::Identifier:
+            {
+                auto &identifier = static_cast<const AST_Identifier &>(node);
+                writer.appendName(Delimiter);
+                writer.appendName(identifier.name);
+                writer.appendName(identifier.isArray ? "(Array)" : "");
+                break;
+            }
+            case ASTKind::BinaryOperator:
+                writer.appendName(Delimiter);
+                writer.appendName(static_cast<const AST_BinaryOperator &>(node).op);
+                break;
+            case ASTKind::StructDeclaration:
+                writer.appendName(Delimiter);
+                writer.appendName(static_cast<const AST_StructDeclaration &>(node).name->name);
+                break;
+            case ASTKind::Literal:
+                writer.appendName(Delimiter);
+                writer.appendName(static_cast<const AST_Literal &>(node).value);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void leave(const AST_Node &)
+    {
+        writer.endNode();
+    }
+
+private:
+    JsonWriter &writer;
+};
+
+}
+
+void AST_Node::print(const std::string &prefix) const
+{
+    ASTPrinter printer(prefix);
+    printer.walk(*this);
+}
+
+void AST_Node::writeJson(JsonWriter &writer) const
+{
+    JsonVisitor visitor(writer);
+    visitor.walk(*this);
+}
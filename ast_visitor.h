@@ -0,0 +1,252 @@
+#ifndef SLANG_AST_VISITOR_H
+#define SLANG_AST_VISITOR_H
+
+#include "absyn.h"
+
+/*
+ * forEachChild: call visit(const AST_Node &) on every child of node, in the
+ * order -dump-ast prints them. Children that are absent are skipped.
+ */
+template<typename Visit>
+void forEachChild(const AST_Node &node, Visit &&visit)
+{
+    auto child = [&visit](const AST_Node *child)
+    {
+        if (child)
+        {
+            visit(*child);
+        }
+    };
+    auto list = [&child](const AST_ExpressionList *expressions)
+    {
+        if (expressions)
+        {
+            for (auto &expression : *expressions)
+            {
+                child(expression.get());
+            }
+        }
+    };
+
+    switch (node.getKind())
+    {
+        case ASTKind::Identifier:
+        {
+            auto &identifier = static_cast<const AST_Identifier &>(node);
+            if (identifier.isArray)
+            {
+                list(identifier.arraySize.get());
+            }
+            break;
+        }
+        case ASTKind::MethodCall:
+        {
+            auto &call = static_cast<const AST_MethodCall &>(node);
+            child(call.id.get());
+            list(call.arguments.get());
+            break;
+        }
+        case ASTKind::BinaryOperator:
+        {
+            auto &binary = static_cast<const AST_BinaryOperator &>(node);
+            child(binary.lhs.get());
+            child(binary.rhs.get());
+            break;
+        }
+        case ASTKind::Assignment:
+        {
+            auto &assignment = static_cast<const AST_Assignment &>(node);
+            child(assignment.lhs.get());
+            child(assignment.rhs.get());
+            break;
+        }
+        case ASTKind::Block:
+            for (auto &statement : *static_cast<const AST_Block &>(node).statements)
+            {
+                child(statement.get());
+            }
+            break;
+        case ASTKind::ExpressionStatement:
+            child(static_cast<const AST_ExpressionStatement &>(node).expression.get());
+            break;
+        case ASTKind::VariableDeclaration:
+        {
+            auto &declaration = static_cast<const AST_VariableDeclaration &>(node);
+            child(declaration.type.get());
+            child(declaration.id.get());
+            child(declaration.assignmentExpr.get());
+            break;
+        }
+        case ASTKind::FunctionDeclaration:
+        {
+            auto &function = static_cast<const AST_FunctionDeclaration &>(node);
+            child(function.type.get());
+            child(function.id.get());
+            for (auto &argument : *function.arguments)
+            {
+                child(argument.get());
+            }
+            child(function.block.get());
+            break;
+        }
+        case ASTKind::StructDeclaration:
+            for (auto &member : *static_cast<const AST_StructDeclaration &>(node).members)
+            {
+                child(member.get());
+            }
+            break;
+        case ASTKind::ReturnStatement:
+            child(static_cast<const AST_ReturnStatement &>(node).expression.get());
+            break;
+        case ASTKind::IfStatement:
+        {
+            auto &statement = static_cast<const AST_IfStatement &>(node);
+            child(statement.condition.get());
+            child(statement.trueBlock.get());
+            child(statement.falseBlock.get());
+            break;
+        }
+        case ASTKind::ForStatement:
+        {
+            auto &statement = static_cast<const AST_ForStatement &>(node);
+            child(statement.initial.get());
+            child(statement.condition.get());
+            child(statement.increment.get());
+            child(statement.block.get());
+            break;
+        }
+        case ASTKind::ArrayIndex:
+        {
+            auto &index = static_cast<const AST_ArrayIndex &>(node);
+            child(index.arrayName.get());
+            list(index.expressions.get());
+            break;
+        }
+        case ASTKind::ArrayAssignment:
+        {
+            auto &assignment = static_cast<const AST_ArrayAssignment &>(node);
+            child(assignment.arrayIndex.get());
+            child(assignment.expression.get());
+            break;
+        }
+        case ASTKind::ArrayInitialization:
+        {
+            auto &initialization = static_cast<const AST_ArrayInitialization &>(node);
+            child(initialization.declaration.get());
+            list(initialization.expressionList.get());
+            break;
+        }
+        case ASTKind::StructMember:
+        {
+            auto &member = static_cast<const AST_StructMember &>(node);
+            child(member.id.get());
+            child(member.member.get());
+            if (member.isArray)
+            {
+                child(member.array.get());
+            }
+            break;
+        }
+        case ASTKind::StructAssignment:
+        {
+            auto &assignment = static_cast<const AST_StructAssignment &>(node);
+            child(assignment.structMember.get());
+            child(assignment.expression.get());
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/*
+ * ASTVisitor: depth-first walk over the AST with a hook before and after the
+ * children of every node. Derived classes hide the hooks they need:
+ *
+ *     class CountIntegers : public ASTVisitor<CountIntegers>
+ *     {
+ *     public:
+ *         unsigned integers = 0;
+ *
+ *         void enter(const AST_Node &node)
+ *         {
+ *             integers += node.getKind() == ASTKind::Integer;
+ *         }
+ *     };
+ *
+ *     CountIntegers counter;
+ *     counter.walk(*programBlock);
+ *
+ * The hooks are resolved at compile time, several visitors can share one walk
+ * with FusedVisitor.
+ */
+template<typename Derived>
+class ASTVisitor
+{
+public:
+    void walk(const AST_Node &node)
+    {
+        Derived &derived = static_cast<Derived &>(*this);
+        derived.enter(node);
+        forEachChild(node, [this](const AST_Node &child)
+        {
+            walk(child);
+        });
+        derived.leave(node);
+    }
+
+    void enter(const AST_Node &)
+    {}
+
+    void leave(const AST_Node &)
+    {}
+};
+
+/*
+ * FusedVisitor: runs the hooks of several visitors in one walk. enter hooks
+ * run in the order the visitors are given, leave hooks in reverse, as if
+ * each visitor had walked the tree alone. See fuseVisitors().
+ */
+template<typename... Visitors>
+class FusedVisitor;
+
+template<>
+class FusedVisitor<> : public ASTVisitor<FusedVisitor<>>
+{
+};
+
+template<typename First, typename... Rest>
+class FusedVisitor<First, Rest...> : public ASTVisitor<FusedVisitor<First, Rest...>>
+{
+public:
+    explicit FusedVisitor(First &first, Rest &... rest) : first(first), rest(rest...)
+    {}
+
+    void enter(const AST_Node &node)
+    {
+        first.enter(node);
+        rest.enter(node);
+    }
+
+    void leave(const AST_Node &node)
+    {
+        rest.leave(node);
+        first.leave(node);
+    }
+
+private:
+    First &first;
+    FusedVisitor<Rest...> rest;
+};
+
+/*
+ * fuseVisitors: fuseVisitors(a, b, c).walk(node) does what a.walk(node),
+ * b.walk(node) and c.walk(node) would, in a single pass over the tree.
+ */
+template<typename... Visitors>
+FusedVisitor<Visitors...> fuseVisitors(Visitors &... visitors)
+{
+    return FusedVisitor<Visitors...>(visitors...);
+}
+
+#endif //SLANG_AST_VISITOR_H
@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+# Compare the -O0 IR size and compile time with and without AST folding, on a
+# generated input full of the constant expressions the grammar produces:
+# negation, compound assignment, literal arithmetic and disabled debug code.
+#
+# Usage: bench/ast_fold.sh <path/to/Slang> [functions] [runs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [functions] [runs]"}
+FUNCTIONS=${2:-2000}
+RUNS=${3:-5}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SRC="$WORK/literals.c"
+{
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        cat <<SLANG
+int f$f(int a, int b)
+{
+    int i;
+    int s = -$f;
+    for (i = 0; i < a; i++)
+    {
+        s += i * 8 + 60 * 60 * 24;
+        s = s * 1 + (1 << 4) - 2 * 3;
+        if (0)
+        {
+            s = s - b * 100;
+        }
+        b -= -1;
+    }
+    return s + 0;
+}
+
+SLANG
+    done
+    echo "int main()"
+    echo "{"
+    echo "    int r = 0;"
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        echo "    r = r + f$f($f, 3);"
+    done
+    echo "    return r;"
+    echo "}"
+} > "$SRC"
+
+echo "input: $(wc -l < "$SRC") lines, $FUNCTIONS functions"
+"$SLANG" -c -O0 -ast-fold-stats "$SRC" -o "$WORK/literals.o"
+
+run()
+{
+    local name=$1
+    shift
+    "$SLANG" -S -emit-llvm -O0 "$@" "$SRC" -o "$WORK/$name.ll" > /dev/null
+    local start=$(date +%s%N)
+    for ((i = 0; i < RUNS; i++)); do
+        "$SLANG" -c -O0 "$@" "$SRC" -o "$WORK/$name.o" > /dev/null
+    done
+    local end=$(date +%s%N)
+    printf "%-12s %8d IR lines %10.1f ms\n" "$name" "$(wc -l < "$WORK/$name.ll")" \
+        "$(echo "($end - $start) / $RUNS / 1000000" | bc -l)"
+}
+
+run no-fold -fno-ast-fold
+run fold
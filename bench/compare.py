@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Compare slang-bench results against a stored baseline.
+
+A phase regresses when its lines/second drops, or its peak RSS grows, by
+more than the threshold. Exits 1 if any phase regressed, so CI can hold the
+compiler to its throughput budget.
+
+Usage: bench/compare.py <baseline.json> <current.json> [--threshold 0.10]
+
+Record a baseline on the machine that runs the comparison:
+    slang-bench -functions=2000 -o bench/baseline.json
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    phases = {phase["name"]: phase for phase in results["phases"]}
+    phases["total"] = results["total"]
+    return results, phases
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed relative slowdown or growth (default: 0.10)")
+    args = parser.parse_args()
+
+    baseline, baseline_phases = load(args.baseline)
+    current, current_phases = load(args.current)
+    if baseline["program"] != current["program"] or \
+            baseline["optimization_level"] != current["optimization_level"]:
+        print("warning: the runs compiled different programs or options, "
+              "the comparison is not meaningful", file=sys.stderr)
+
+    regressions = 0
+    print("%-20s %14s %14s %8s %12s %12s %8s" % (
+        "phase", "base lines/s", "lines/s", "change", "base RSS KB", "RSS KB", "change"))
+    for name, base in baseline_phases.items():
+        now = current_phases.get(name)
+        if now is None:
+            print("%-20s missing from %s" % (name, args.current))
+            continue
+        speed = now["lines_per_second"] / base["lines_per_second"] - 1 if base["lines_per_second"] else 0.0
+        memory = now["peak_rss_kb"] / base["peak_rss_kb"] - 1 if base["peak_rss_kb"] else 0.0
+        flags = []
+        if speed < -args.threshold:
+            flags.append("SLOWER")
+        if memory > args.threshold:
+            flags.append("LARGER")
+        regressions += bool(flags)
+        print("%-20s %14.0f %14.0f %+7.1f%% %12d %12d %+7.1f%% %s" % (
+            name, base["lines_per_second"], now["lines_per_second"], 100 * speed,
+            base["peak_rss_kb"], now["peak_rss_kb"], 100 * memory, " ".join(flags)))
+
+    if regressions:
+        print("%d phase(s) regressed by more than %.0f%%" % (regressions, 100 * args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+# Compile requests per second through 'Slang -daemon' and slang-client,
+# against starting Slang for every compile.
+#
+# Usage: bench/daemon_throughput.sh <path/to/Slang> <path/to/slang-client> [requests] [jobs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> <path/to/slang-client> [requests] [jobs]"}
+CLIENT=${2:?"usage: $0 <path/to/Slang> <path/to/slang-client> [requests] [jobs]"}
+REQUESTS=${3:-2000}
+JOBS=${4:-$(nproc)}
+WORK=$(mktemp -d)
+export SLANG_DAEMON_SOCKET="$WORK/slang.sock"
+trap 'kill $DAEMON 2> /dev/null; rm -rf "$WORK"' EXIT
+
+for ((r = 0; r < REQUESTS; r++)); do
+    cat > "$WORK/r$r.c" <<SLANG
+int f(int n)
+{
+    int i;
+    int s;
+    s = 0;
+    for (i = 0; i < n; i++)
+    {
+        s = s + i * $r;
+    }
+    return s;
+}
+SLANG
+done
+
+run()
+{
+    local compiler=$1
+    local start=$(date +%s%N)
+    seq 0 $((REQUESTS - 1)) | xargs -P "$JOBS" -I{} "$compiler" -c -O2 "$WORK/r{}.c" -o "$WORK/r{}.o" > /dev/null
+    local end=$(date +%s%N)
+    printf "%-8s %10.1f requests/s\n" "$2" "$(echo "$REQUESTS * 1000000000 / ($end - $start)" | bc -l)"
+}
+
+run "$SLANG" direct
+
+"$SLANG" -daemon="$SLANG_DAEMON_SOCKET" &
+DAEMON=$!
+while [ ! -S "$SLANG_DAEMON_SOCKET" ]; do
+    sleep 0.1
+done
+run "$CLIENT" daemon
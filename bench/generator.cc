@@ -0,0 +1,250 @@
+#include <random>
+#include <sstream>
+#include "generator.h"
+
+namespace
+{
+    const char *arithmeticOps[] = {"+", "-", "*", "&", "|", "^"};
+    const char *relationalOps[] = {"<", ">", "<=", ">=", "==", "!="};
+    const unsigned Locals = 4;
+
+    /*
+     * ProgramWriter: emits one program. Only the raw engine output is used,
+     * the standard distributions differ between library implementations.
+     */
+    class ProgramWriter
+    {
+    public:
+        explicit ProgramWriter(const GeneratorOptions &options) : options(options), random(options.seed)
+        {
+        }
+
+        std::string write()
+        {
+            for (unsigned i = 0; i < options.structs; i++)
+            {
+                writeStruct(i);
+            }
+            for (unsigned i = 0; i < options.functions; i++)
+            {
+                writeFunction(i);
+            }
+            out << "int main()\n{\n    int r = 0;\n";
+            if (options.functions > 0)
+            {
+                out << "    r = f" << options.functions - 1 << "(1, 2);\n";
+            }
+            out << "    return r;\n}\n";
+            return out.str();
+        }
+
+    private:
+        const GeneratorOptions &options;
+        std::mt19937_64 random;
+        std::ostringstream out;
+        unsigned function = 0;
+
+        unsigned pick(unsigned n)
+        {
+            return n ? (unsigned) (random() % n) : 0;
+        }
+
+        void indent(unsigned level)
+        {
+            out << std::string(4 * level, ' ');
+        }
+
+        bool hasStruct() const
+        {
+            return options.structs > 0 && options.structMembers > 0;
+        }
+
+        std::string local()
+        {
+            return "x" + std::to_string(pick(Locals));
+        }
+
+        std::string operand()
+        {
+            switch (pick(8))
+            {
+                case 0:
+                    return pick(2) ? "a" : "b";
+                case 1:
+                case 2:
+                    return std::to_string(pick(1000));
+                case 3:
+                    if (hasStruct())
+                    {
+                        return "s.m" + std::to_string(pick(options.structMembers));
+                    }
+                    break;
+                case 4:
+                    if (options.arraySize > 0)
+                    {
+                        return "table[" + std::to_string(pick(options.arraySize)) + "]";
+                    }
+                    break;
+                case 5:
+                    // Calls go to earlier functions only, so the call graph stays acyclic.
+                    if (function > 0 && pick(4) == 0)
+                    {
+                        return "f" + std::to_string(pick(function)) + "(" + local() + ", " + local() + ")";
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return local();
+        }
+
+        /*
+         * expression: a chain of length operands, sub-chains are parenthesized at random.
+         */
+        std::string expression(unsigned length)
+        {
+            std::string text = operand();
+            unsigned i = 1;
+            while (i < length)
+            {
+                text += " ";
+                text += arithmeticOps[pick(6)];
+                text += " ";
+                unsigned group = 2 + pick(3);
+                if (pick(4) == 0 && i + group <= length)
+                {
+                    text += "(" + expression(group) + ")";
+                    i += group;
+                } else
+                {
+                    text += operand();
+                    i++;
+                }
+            }
+            return text;
+        }
+
+        std::string condition()
+        {
+            return local() + " " + relationalOps[pick(6)] + " " + expression(1 + options.expressionLength / 4);
+        }
+
+        void writeAssignment(unsigned level)
+        {
+            indent(level);
+            unsigned target = pick(4);
+            if (target == 0 && hasStruct())
+            {
+                out << "s.m" << pick(options.structMembers);
+            } else if (target == 1 && options.arraySize > 0)
+            {
+                out << "table[" << pick(options.arraySize) << "]";
+            } else
+            {
+                out << local();
+            }
+            out << " = " << expression(options.expressionLength) << ";\n";
+        }
+
+        void writeBlock(unsigned level, unsigned depth)
+        {
+            unsigned nested = pick(options.statements);
+            for (unsigned i = 0; i < options.statements; i++)
+            {
+                if (i == nested && depth > 0)
+                {
+                    writeNested(level, depth - 1);
+                } else
+                {
+                    writeAssignment(level);
+                }
+            }
+        }
+
+        void writeNested(unsigned level, unsigned depth)
+        {
+            std::string counter = local();
+            switch (pick(3))
+            {
+                case 0:
+                    indent(level);
+                    out << "if (" << condition() << ")\n";
+                    indent(level);
+                    out << "{\n";
+                    writeBlock(level + 1, depth);
+                    indent(level);
+                    out << "}\n";
+                    indent(level);
+                    out << "else\n";
+                    indent(level);
+                    out << "{\n";
+                    writeBlock(level + 1, depth);
+                    indent(level);
+                    out << "}\n";
+                    break;
+                case 1:
+                    indent(level);
+                    out << "while (" << counter << " < " << 1 + pick(100) << ")\n";
+                    indent(level);
+                    out << "{\n";
+                    writeBlock(level + 1, depth);
+                    indent(level + 1);
+                    out << counter << "++;\n";
+                    indent(level);
+                    out << "}\n";
+                    break;
+                default:
+                    indent(level);
+                    out << "for (" << counter << " = 0; " << counter << " < " << 1 + pick(100) << "; " << counter
+                        << "++)\n";
+                    indent(level);
+                    out << "{\n";
+                    writeBlock(level + 1, depth);
+                    indent(level);
+                    out << "}\n";
+                    break;
+            }
+        }
+
+        void writeStruct(unsigned index)
+        {
+            out << "struct S" << index << "\n{\n";
+            for (unsigned i = 0; i < options.structMembers; i++)
+            {
+                out << "    int m" << i << ";\n";
+            }
+            out << "};\n\n";
+        }
+
+        void writeFunction(unsigned index)
+        {
+            function = index;
+            out << "int f" << index << "(int a, int b)\n{\n";
+            out << "    int x0 = a;\n    int x1 = b;\n";
+            for (unsigned i = 2; i < Locals; i++)
+            {
+                out << "    int x" << i << " = " << pick(100) << ";\n";
+            }
+            if (hasStruct())
+            {
+                out << "    struct S" << pick(options.structs) << " s;\n";
+            }
+            if (options.arraySize > 0)
+            {
+                out << "    int table[" << options.arraySize << "] = {";
+                for (unsigned i = 0; i < options.arraySize; i++)
+                {
+                    out << (i == 0 ? "" : i % 16 == 0 ? ",\n        " : ", ") << pick(1000);
+                }
+                out << "};\n";
+            }
+            writeBlock(1, options.depth);
+            out << "    return " << expression(options.expressionLength) << ";\n}\n\n";
+        }
+    };
+}
+
+std::string generateProgram(const GeneratorOptions &options)
+{
+    return ProgramWriter(options).write();
+}
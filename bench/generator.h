@@ -0,0 +1,35 @@
+#ifndef SLANG_BENCH_GENERATOR_H
+#define SLANG_BENCH_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+/*
+ * GeneratorOptions: shape of a synthetic Slang program. Every knob scales
+ * one part of the front end: functions the whole pipeline, depth the block
+ * stack, expressionLength the expression grammar, arraySize the initializer
+ * lists and structs the type tables.
+ */
+struct GeneratorOptions
+{
+    uint64_t seed = 1;
+    unsigned functions = 200;
+    // Nesting of if/while/for blocks in every function.
+    unsigned depth = 4;
+    // Statements per block, one of them opens the next nesting level.
+    unsigned statements = 4;
+    // Operands of every expression chain.
+    unsigned expressionLength = 12;
+    // Elements of the initialized array of every function, 0 for none.
+    unsigned arraySize = 64;
+    unsigned structs = 20;
+    unsigned structMembers = 6;
+};
+
+/*
+ * generateProgram: a valid Slang program of the given shape. The output only
+ * depends on the options, the same seed gives the same program on every host.
+ */
+std::string generateProgram(const GeneratorOptions &options);
+
+#endif //SLANG_BENCH_GENERATOR_H
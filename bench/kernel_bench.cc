@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <json/json.h>
+
+/*
+ * slang-kernels: run time of Slang's generated code. Every kernel is built
+ * by Slang at -O0..-O3 and by a C compiler at -O2, run with warm-up and
+ * repetitions, and reported as a ratio to the C compiler's time. Hardware
+ * counters are read with perf_event_open where the kernel allows it.
+ */
+
+#ifndef SLANG_COMPILER_PATH
+#define SLANG_COMPILER_PATH "Slang"
+#endif
+#ifndef SLANG_KERNEL_DIR
+#define SLANG_KERNEL_DIR "bench/kernels"
+#endif
+
+static const char *DefaultKernels[] = {"matmul", "stencil", "prefix_sum", "sort", "hash_probe", "points"};
+static const char *Levels[] = {"-O0", "-O1", "-O2", "-O3"};
+
+struct CounterSpec
+{
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+};
+
+static const CounterSpec Counters[] = {
+        {"cycles",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"cache_misses",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}};
+static const size_t CounterCount = sizeof(Counters) / sizeof(Counters[0]);
+
+/*
+ * Run: one execution of a kernel.
+ */
+struct Run
+{
+    double seconds = 0;
+    int status = -1;
+    // -1 where the counter could not be opened.
+    int64_t counters[CounterCount];
+};
+
+/*
+ * openCounter: count event for pid's user space from its exec() on.
+ * @return the descriptor, -1 if perf events are unavailable or not permitted.
+ */
+static int openCounter(const CounterSpec &spec, pid_t pid)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    // Allowed at perf_event_paranoid 2, the default of most distributions.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open, &attr, pid, -1, -1, 0);
+}
+
+/*
+ * runOnce: run binary in a child, with counters attached before it execs.
+ */
+static Run runOnce(const std::string &binary)
+{
+    Run run;
+    std::fill(run.counters, run.counters + CounterCount, -1);
+
+    // The child waits on the pipe until its counters are open.
+    int ready[2];
+    if (pipe(ready) != 0)
+    {
+        return run;
+    }
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(ready[1]);
+        char go;
+        if (read(ready[0], &go, 1) != 1)
+        {
+            _exit(127);
+        }
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDOUT_FILENO);
+        execl(binary.c_str(), binary.c_str(), (char *) nullptr);
+        _exit(127);
+    }
+    close(ready[0]);
+    if (pid < 0)
+    {
+        close(ready[1]);
+        return run;
+    }
+
+    int fds[CounterCount];
+    for (size_t i = 0; i < CounterCount; i++)
+    {
+        fds[i] = openCounter(Counters[i], pid);
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (write(ready[1], "x", 1) != 1)
+    {
+        kill(pid, SIGKILL);
+    }
+    close(ready[1]);
+    int status;
+    waitpid(pid, &status, 0);
+    auto end = std::chrono::steady_clock::now();
+
+    run.seconds = std::chrono::duration<double>(end - start).count();
+    run.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    for (size_t i = 0; i < CounterCount; i++)
+    {
+        uint64_t value;
+        if (fds[i] >= 0 && read(fds[i], &value, sizeof(value)) == sizeof(value))
+        {
+            run.counters[i] = (int64_t) value;
+        }
+        if (fds[i] >= 0)
+        {
+            close(fds[i]);
+        }
+    }
+    return run;
+}
+
+/*
+ * measure: warm-up runs, then the run with the median time of the repetitions.
+ */
+static Run measure(const std::string &binary, unsigned warmup, unsigned repetitions)
+{
+    for (unsigned i = 0; i < warmup; i++)
+    {
+        runOnce(binary);
+    }
+    std::vector<Run> runs;
+    for (unsigned i = 0; i < repetitions; i++)
+    {
+        runs.push_back(runOnce(binary));
+    }
+    std::sort(runs.begin(), runs.end(), [](const Run &a, const Run &b)
+    {
+        return a.seconds < b.seconds;
+    });
+    return runs[runs.size() / 2];
+}
+
+static bool build(const std::string &command)
+{
+    return system((command + " > /dev/null 2>&1").c_str()) == 0;
+}
+
+static Json::Value toJson(const Run &run, const Run &reference)
+{
+    Json::Value value;
+    value["seconds"] = run.seconds;
+    value["ratio"] = reference.seconds > 0 ? run.seconds / reference.seconds : 0.0;
+    value["exit_status"] = run.status;
+    for (size_t i = 0; i < CounterCount; i++)
+    {
+        if (run.counters[i] >= 0)
+        {
+            value[Counters[i].name] = (Json::Int64) run.counters[i];
+        }
+    }
+    return value;
+}
+
+static void printRow(const std::string &kernel, const std::string &compiler, const Run &run, const Run &reference)
+{
+    printf("%-12s %-10s %10.1f %8.2fx", kernel.c_str(), compiler.c_str(), run.seconds * 1e3,
+           reference.seconds > 0 ? run.seconds / reference.seconds : 0.0);
+    if (run.counters[0] > 0 && run.counters[1] >= 0)
+    {
+        printf(" %14lld %6.2f %12lld %12lld", (long long) run.counters[1],
+               (double) run.counters[1] / run.counters[0], (long long) run.counters[2], (long long) run.counters[3]);
+    }
+    if (run.status != reference.status)
+    {
+        printf("  WRONG RESULT (%d, expected %d)", run.status, reference.status);
+    }
+    printf("\n");
+}
+
+static void showHelpInfo()
+{
+    std::cout << "USAGE: slang-kernels [options] [kernel...]\n" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  -slang=<path>              Slang compiler to test" << std::endl;
+    std::cout << "  -cc=<compiler>             Reference C compiler, run at -O2 (default: clang)" << std::endl;
+    std::cout << "  -kernels=<dir>             Directory of the kernel sources" << std::endl;
+    std::cout << "  -warmup=<n>                Untimed runs before measuring" << std::endl;
+    std::cout << "  -repetitions=<n>           Timed runs, the median is reported" << std::endl;
+    std::cout << "  -o <file>                  Also write the results as JSON to <file>" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    std::string slang = SLANG_COMPILER_PATH;
+    std::string cc = "clang";
+    std::string kernelDir = SLANG_KERNEL_DIR;
+    std::string resultFile;
+    unsigned warmup = 1;
+    unsigned repetitions = 5;
+    std::vector<std::string> kernels;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--help") == 0)
+        {
+            showHelpInfo();
+            return EXIT_SUCCESS;
+        } else if (strncmp(argv[i], "-slang=", 7) == 0)
+        {
+            slang = std::string(argv[i] + 7);
+        } else if (strncmp(argv[i], "-cc=", 4) == 0)
+        {
+            cc = std::string(argv[i] + 4);
+        } else if (strncmp(argv[i], "-kernels=", 9) == 0)
+        {
+            kernelDir = std::string(argv[i] + 9);
+        } else if (strncmp(argv[i], "-warmup=", 8) == 0)
+        {
+            warmup = (unsigned) atoi(argv[i] + 8);
+        } else if (strncmp(argv[i], "-repetitions=", 13) == 0)
+        {
+            repetitions = (unsigned) std::max(1, atoi(argv[i] + 13));
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            resultFile = std::string(argv[++i]);
+        } else if (argv[i][0] == '-')
+        {
+            fprintf(stderr, "slang-kernels:\033[1;31m error:\033[0m unknown argument: '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        } else
+        {
+            kernels.push_back(std::string(argv[i]));
+        }
+    }
+    if (kernels.empty())
+    {
+        kernels.assign(std::begin(DefaultKernels), std::end(DefaultKernels));
+    }
+
+    char work[] = "/tmp/slang-kernels-XXXXXX";
+    if (!mkdtemp(work))
+    {
+        fprintf(stderr, "slang-kernels:\033[1;31m error:\033[0m cannot create a work directory\n");
+        return EXIT_FAILURE;
+    }
+
+    int probe = openCounter(Counters[0], 0);
+    if (probe < 0)
+    {
+        fprintf(stderr, "slang-kernels: hardware counters unavailable (%s), reporting times only\n",
+                strerror(errno));
+    } else
+    {
+        close(probe);
+    }
+
+    printf("%-12s %-10s %10s %9s %14s %6s %12s %12s\n", "kernel", "compiler", "time (ms)", "vs cc", "instructions",
+           "IPC", "br-misses", "cache-misses");
+    Json::Value root;
+    root["reference"] = cc + " -O2";
+    root["repetitions"] = repetitions;
+    bool failed = false;
+    for (auto &kernel : kernels)
+    {
+        std::string source = kernelDir + "/" + kernel + ".c";
+        std::string binary = std::string(work) + "/" + kernel;
+        Json::Value &result = root["kernels"][kernel];
+
+        // The kernels are written in the subset of C that Slang and C compilers share.
+        if (!build(cc + " -O2 -w " + source + " -o " + binary + ".cc"))
+        {
+            fprintf(stderr, "slang-kernels:\033[1;31m error:\033[0m %s cannot compile %s\n", cc.c_str(),
+                    source.c_str());
+            failed = true;
+            continue;
+        }
+        Run reference = measure(binary + ".cc", warmup, repetitions);
+        printRow(kernel, cc + " -O2", reference, reference);
+        result[cc + " -O2"] = toJson(reference, reference);
+
+        for (const char *level : Levels)
+        {
+            std::string output = binary + level;
+            if (!build(slang + " " + level + " " + source + " -o " + output))
+            {
+                fprintf(stderr, "slang-kernels:\033[1;31m error:\033[0m Slang %s cannot compile %s\n", level,
+                        source.c_str());
+                failed = true;
+                continue;
+            }
+            Run run = measure(output, warmup, repetitions);
+            printRow(kernel, std::string("slang ") + level, run, reference);
+            result[std::string("slang ") + level] = toJson(run, reference);
+            failed = failed || run.status != reference.status;
+        }
+    }
+
+    system((std::string("rm -rf ") + work).c_str());
+    if (!resultFile.empty())
+    {
+        std::ofstream os(resultFile);
+        os << root;
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
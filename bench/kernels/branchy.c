@@ -0,0 +1,45 @@
+extern int printf(char str, int arg1);
+
+extern int puts(char str);
+
+int cold(int x)
+{
+    int i;
+    int s = x;
+    for (i = 0; i < 16; i++)
+    {
+        s = s * 31 + i;
+        s = s & 1048575;
+    }
+    return s;
+}
+
+int hot(int x)
+{
+    return (x >> 3) + 7;
+}
+
+int main()
+{
+    int i;
+    int x = 12345;
+    int sum = 0;
+
+    /* About 98% of the iterations take the first branch. */
+    for (i = 0; i < 100000000; i++)
+    {
+        x = (x * 1103515245 + 12345) & 2147483647;
+        if ((x & 1023) < 1000)
+        {
+            sum = sum + hot(x);
+        } else
+        {
+            sum = sum + cold(x);
+        }
+        sum = sum & 16777215;
+    }
+    printf("sum = %d", sum);
+    puts("");
+
+    return 0;
+}
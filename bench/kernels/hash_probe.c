@@ -0,0 +1,56 @@
+/* Open addressing hash table with linear probing, 64K slots at 60% load. */
+
+int keys[65536];
+int values[65536];
+
+int insert(int key, int value)
+{
+    int slot = (key * 40503) & 65535;
+    while (keys[slot] != 0 && keys[slot] != key)
+    {
+        slot = (slot + 1) & 65535;
+    }
+    keys[slot] = key;
+    values[slot] = value;
+    return slot;
+}
+
+int lookup(int key)
+{
+    int slot = (key * 40503) & 65535;
+    int result = -1;
+    while (keys[slot] != 0 && result == -1)
+    {
+        if (keys[slot] == key)
+        {
+            result = values[slot];
+        }
+        slot = (slot + 1) & 65535;
+    }
+    return result;
+}
+
+int main()
+{
+    int i;
+    int key;
+    int hits = 0;
+    int sum = 0;
+    int found;
+    for (i = 1; i < 40000; i++)
+    {
+        insert(i, i & 255);
+    }
+    /* Keys up to 50000, one lookup in five misses. */
+    for (i = 0; i < 20000000; i++)
+    {
+        key = 1 + ((i % 50000) * 7919) % 50000;
+        found = lookup(key);
+        if (found >= 0)
+        {
+            hits++;
+            sum = (sum + found) & 1048575;
+        }
+    }
+    return (hits + sum) & 255;
+}
@@ -0,0 +1,14 @@
+int scale(int x, int k)
+{
+    return x * k + 1;
+}
+
+int clamp(int x, int hi)
+{
+    return x & hi;
+}
+
+int mix(int a, int b)
+{
+    return (a << 5) + (a >> 2) + b;
+}
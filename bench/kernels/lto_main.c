@@ -0,0 +1,26 @@
+extern int printf(char str, int arg1);
+
+extern int puts(char str);
+
+extern int scale(int x, int k);
+
+extern int clamp(int x, int hi);
+
+extern int mix(int a, int b);
+
+int main()
+{
+    int i;
+    int acc = 1;
+
+    /* Every call crosses into lto_lib.c and is an inlining candidate under ThinLTO. */
+    for (i = 0; i < 200000000; i++)
+    {
+        acc = mix(acc, scale(i, 3));
+        acc = clamp(acc, 1048575);
+    }
+    printf("acc = %d", acc);
+    puts("");
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/* Dense 256x256 double matrix multiply, i-k-j order. */
+
+double a[65536];
+double b[65536];
+double c[65536];
+
+int init()
+{
+    int i;
+    for (i = 0; i < 65536; i++)
+    {
+        a[i] = (i % 17) * 0.5;
+        b[i] = (i % 13) * 0.25;
+        c[i] = 0.0;
+    }
+    return 0;
+}
+
+int multiply()
+{
+    int i;
+    int j;
+    int k;
+    double aik;
+    for (i = 0; i < 256; i++)
+    {
+        for (k = 0; k < 256; k++)
+        {
+            aik = a[i * 256 + k];
+            for (j = 0; j < 256; j++)
+            {
+                c[i * 256 + j] += aik * b[k * 256 + j];
+            }
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    int i;
+    int count = 0;
+    init();
+    for (i = 0; i < 16; i++)
+    {
+        multiply();
+    }
+    for (i = 0; i < 65536; i++)
+    {
+        if (c[i] > 24600.0)
+        {
+            count++;
+        }
+    }
+    return count & 255;
+}
@@ -0,0 +1,48 @@
+/* Traversal of an array of structs, as test3.c's struct Point arrays. */
+
+struct Point
+{
+    double x;
+    int y;
+};
+
+struct Point points[65536];
+
+int init()
+{
+    int i;
+    for (i = 0; i < 65536; i++)
+    {
+        points[i].x = (i % 100) * 0.01;
+        points[i].y = i & 127;
+    }
+    return 0;
+}
+
+int update()
+{
+    int i;
+    int count = 0;
+    for (i = 0; i < 65536; i++)
+    {
+        points[i].x = points[i].x * 0.5 + points[i].y;
+        points[i].y = (points[i].y * 3 + 1) & 127;
+        if (points[i].x > 100.0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+int main()
+{
+    int i;
+    int count = 0;
+    init();
+    for (i = 0; i < 2000; i++)
+    {
+        count = (count + update()) & 1048575;
+    }
+    return count & 255;
+}
@@ -0,0 +1,35 @@
+/* Inclusive prefix sum over 1M ints, a loop-carried dependence. */
+
+int data[1048576];
+
+int init(int seed)
+{
+    int i;
+    for (i = 0; i < 1048576; i++)
+    {
+        data[i] = (i * 7 + seed) % 1000;
+    }
+    return 0;
+}
+
+int scan()
+{
+    int i;
+    for (i = 1; i < 1048576; i++)
+    {
+        data[i] = (data[i] + data[i - 1]) & 1048575;
+    }
+    return data[1048575];
+}
+
+int main()
+{
+    int i;
+    int sum = 0;
+    for (i = 0; i < 200; i++)
+    {
+        init(i);
+        sum = (sum + scan()) & 1048575;
+    }
+    return sum & 255;
+}
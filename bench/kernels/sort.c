@@ -0,0 +1,69 @@
+/* Shell sort of 200000 pseudo-random ints, Ciura's gap sequence. */
+
+int values[200000];
+int gaps[8];
+
+int init(int seed)
+{
+    int i;
+    int x = seed;
+    for (i = 0; i < 200000; i++)
+    {
+        x = (x * 75 + 74) % 65537;
+        values[i] = x;
+    }
+    return 0;
+}
+
+int shellSort()
+{
+    int g;
+    int gap;
+    int i;
+    int j;
+    int v;
+    for (g = 0; g < 8; g++)
+    {
+        gap = gaps[g];
+        for (i = gap; i < 200000; i++)
+        {
+            v = values[i];
+            j = i;
+            while (j >= gap && values[j - gap] > v)
+            {
+                values[j] = values[j - gap];
+                j = j - gap;
+            }
+            values[j] = v;
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    int i;
+    int r;
+    int sorted = 0;
+    gaps[0] = 701;
+    gaps[1] = 301;
+    gaps[2] = 132;
+    gaps[3] = 57;
+    gaps[4] = 23;
+    gaps[5] = 10;
+    gaps[6] = 4;
+    gaps[7] = 1;
+    for (r = 0; r < 10; r++)
+    {
+        init(r + 1);
+        shellSort();
+        for (i = 1; i < 200000; i++)
+        {
+            if (values[i - 1] <= values[i])
+            {
+                sorted++;
+            }
+        }
+    }
+    return (sorted + values[100000]) & 255;
+}
@@ -0,0 +1,58 @@
+/* 5-point Jacobi stencil on a 512x512 double grid. */
+
+double grid[262144];
+double next[262144];
+
+int init()
+{
+    int i;
+    for (i = 0; i < 262144; i++)
+    {
+        grid[i] = (i % 31) * 1.0;
+        next[i] = 0.0;
+    }
+    return 0;
+}
+
+int sweep()
+{
+    int i;
+    int j;
+    int p;
+    for (i = 1; i < 511; i++)
+    {
+        for (j = 1; j < 511; j++)
+        {
+            p = i * 512 + j;
+            next[p] = 0.2 * (grid[p] + grid[p - 1] + grid[p + 1] + grid[p - 512] + grid[p + 512]);
+        }
+    }
+    for (i = 1; i < 511; i++)
+    {
+        for (j = 1; j < 511; j++)
+        {
+            p = i * 512 + j;
+            grid[p] = next[p];
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    int i;
+    int count = 0;
+    init();
+    for (i = 0; i < 300; i++)
+    {
+        sweep();
+    }
+    for (i = 0; i < 262144; i++)
+    {
+        if (grid[i] > 15.0)
+        {
+            count++;
+        }
+    }
+    return count & 255;
+}
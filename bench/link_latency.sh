@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# End-to-end compile and link latency of many tiny programs, linking
+# in-process with lld against spawning the clang driver. The programs are
+# built in one directory, also in parallel, to check that concurrent builds
+# don't clobber each other's objects.
+#
+# Usage: bench/link_latency.sh <path/to/Slang> [programs] [jobs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [programs] [jobs]"}
+PROGRAMS=${2:-1000}
+JOBS=${3:-$(nproc)}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+for ((p = 0; p < PROGRAMS; p++)); do
+    cat > "$WORK/p$p.c" <<SLANG
+int main()
+{
+    int x;
+    x = $p;
+    return x - $p;
+}
+SLANG
+done
+
+for linker in lld clang; do
+    start=$(date +%s%N)
+    for ((p = 0; p < PROGRAMS; p++)); do
+        (cd "$WORK" && "$SLANG" -fuse-ld=$linker "p$p.c" -o "p$p" > /dev/null)
+    done
+    end=$(date +%s%N)
+    printf "%-6s serial   %10.3f ms/program\n" "$linker" "$(echo "($end - $start) / 1000000 / $PROGRAMS" | bc -l)"
+
+    rm -f "$WORK"/p*[0-9]
+    start=$(date +%s%N)
+    seq 0 $((PROGRAMS - 1)) | xargs -P "$JOBS" -I{} sh -c "cd '$WORK' && '$SLANG' -fuse-ld=$linker p{}.c -o p{} > /dev/null"
+    end=$(date +%s%N)
+    printf "%-6s -P %-4s %10.3f ms/program\n" "$linker" "$JOBS" "$(echo "($end - $start) / 1000000 / $PROGRAMS" | bc -l)"
+
+    for ((p = 0; p < PROGRAMS; p++)); do
+        if ! "$WORK/p$p"; then
+            echo "p$p: wrong executable" >&2
+            exit 1
+        fi
+    done
+done
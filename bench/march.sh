@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+# Compare run time of the same kernel built for the generic CPU and for the host CPU.
+# First check that -O2 vectorizes the kernel for both, and print the vector types
+# used: exits with 1 if the optimized IR has none.
+#
+# Usage: bench/march.sh <path/to/Slang> [kernel.c] [runs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [kernel.c] [runs]"}
+KERNEL=${2:-$(dirname "$0")/../test/test4.c}
+RUNS=${3:-20}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+vectors()
+{
+    local name=$1
+    shift
+    "$SLANG" -O2 -S -emit-llvm "$@" "$KERNEL" -o "$WORK/$name.ll" > /dev/null
+    local types=$(grep -oE '<[0-9]+ x (double|float|i[0-9]+)>' "$WORK/$name.ll" | sort -u | tr '\n' ' ')
+    if [ -z "$types" ]; then
+        echo "$name: the kernel is not vectorized at -O2"
+        exit 1
+    fi
+    printf "%-16s vector types: %s\n" "$name" "$types"
+}
+
+vectors generic
+vectors native -march=native
+
+run()
+{
+    local name=$1
+    shift
+    "$SLANG" -O3 "$@" "$KERNEL" -o "$WORK/$name" > /dev/null
+    local start=$(date +%s%N)
+    for ((i = 0; i < RUNS; i++)); do
+        "$WORK/$name" > /dev/null
+    done
+    local end=$(date +%s%N)
+    printf "%-16s %10.3f ms/run\n" "$name" "$(echo "($end - $start) / $RUNS / 1000000" | bc -l)"
+}
+
+run generic
+run native -march=native
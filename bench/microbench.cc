@@ -0,0 +1,438 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "IR.h"
+#include "absyn.h"
+#include "ast_visitor.h"
+#include "generator.h"
+#include "options.h"
+#include "parser_state.h"
+#include "sema.h"
+#include "type.h"
+
+/*
+ * slang-microbench: cost of the front end's hot paths, in ns, allocations
+ * and bytes allocated per operation. Inputs come from the slang-bench
+ * generator, so they have the shape of real programs.
+ */
+
+// Reentrant scanner interface, defined by the flex output.
+int yylex_init_extra(ParserState *extra, yyscan_t *scanner);
+
+int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner);
+
+int yylex_destroy(yyscan_t yyscanner);
+
+// Every allocation of the process goes through these while counting is on.
+static bool counting = false;
+static uint64_t allocations = 0;
+static uint64_t allocatedBytes = 0;
+
+void *operator new(size_t size)
+{
+    if (counting)
+    {
+        allocations++;
+        allocatedBytes += size;
+    }
+    void *pointer = malloc(size ? size : 1);
+    if (!pointer)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+static double minimumSeconds = 0.5;
+static std::string filter;
+
+/*
+ * runBenchmark: repeat body until it ran for minimumSeconds in total.
+ * @param ops -- operations done by one call of body.
+ * @param reset -- untimed and uncounted work between calls, e.g. freeing what body built.
+ */
+static void runBenchmark(const std::string &name, uint64_t ops, const std::function<void()> &body,
+                         const std::function<void()> &reset = nullptr)
+{
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+    {
+        return;
+    }
+
+    // One untimed call to fill caches and lazily built tables.
+    body();
+    if (reset)
+    {
+        reset();
+    }
+
+    double seconds = 0;
+    uint64_t iterations = 0;
+    uint64_t totalAllocations = 0;
+    uint64_t totalBytes = 0;
+    while (seconds < minimumSeconds)
+    {
+        allocations = 0;
+        allocatedBytes = 0;
+        counting = true;
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        counting = false;
+        seconds += std::chrono::duration<double>(end - start).count();
+        totalAllocations += allocations;
+        totalBytes += allocatedBytes;
+        iterations++;
+        if (reset)
+        {
+            reset();
+        }
+    }
+
+    double totalOps = (double) iterations * ops;
+    printf("%-36s %12.1f %12.2f %12.1f %12llu\n", name.c_str(), seconds * 1e9 / totalOps,
+           totalAllocations / totalOps, totalBytes / totalOps, (unsigned long long) totalOps);
+}
+
+/*
+ * ownsString: whether the scanner allocated a std::string for token, see SAVE_TOKEN in scanner.l.
+ */
+static bool ownsString(int token)
+{
+    switch (token)
+    {
+        case IDENTIFIER: case I_CONSTANT: case F_CONSTANT: case STRING_LITERAL: case FUNC_NAME:
+        case TYPEDEF: case EXTERN: case STATIC: case REGISTER: case INLINE: case CONST: case RESTRICT:
+        case BOOL: case CHAR: case SHORT: case INT: case LONG: case SIGNED: case UNSIGNED:
+        case FLOAT: case DOUBLE: case VOID: case COMPLEX: case IMAGINARY:
+        case ALIGNAS: case ALIGNOF: case ATOMIC: case GENERIC: case NORETURN: case STATIC_ASSERT:
+        case THREAD_LOCAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * lex: run the scanner over source.
+ * @return the number of tokens.
+ */
+static uint64_t lex(const std::string &source)
+{
+    std::istringstream input(source);
+    ParserState state;
+    state.input = &input;
+    yyscan_t scanner;
+    yylex_init_extra(&state, &scanner);
+    uint64_t tokens = 0;
+    YYSTYPE value;
+    int token;
+    while ((token = yylex(&value, scanner)) != 0)
+    {
+        if (ownsString(token))
+        {
+            // The parser takes these over in a real compile.
+            delete value.string;
+        }
+        tokens++;
+    }
+    yylex_destroy(scanner);
+    return tokens;
+}
+
+static std::shared_ptr<AST_Block> parse(const std::string &source)
+{
+    std::istringstream input(source);
+    ParserState state;
+    state.input = &input;
+    state.filename = "bench.c";
+    if (!parseProgram(state))
+    {
+        fprintf(stderr, "slang-microbench:\033[1;31m error:\033[0m the generated program does not parse\n");
+        exit(EXIT_FAILURE);
+    }
+    return state.programBlock;
+}
+
+static void benchmarkLexer(const std::string &source)
+{
+    uint64_t tokens = lex(source);
+    runBenchmark("yylex (per token)", tokens, [&source]()
+    {
+        lex(source);
+    });
+}
+
+static void benchmarkParser(const std::string &source)
+{
+    uint64_t lines = std::count(source.begin(), source.end(), '\n');
+    std::shared_ptr<AST_Block> root;
+    runBenchmark("yyparse (per line)", lines, [&]()
+    {
+        root = parse(source);
+    }, [&root]()
+    {
+        root = nullptr;
+    });
+}
+
+static void benchmarkSemanticAnalysis(const std::string &source)
+{
+    std::shared_ptr<AST_Block> root = parse(source);
+    uint64_t lines = std::count(source.begin(), source.end(), '\n');
+    Options options;
+    // Struct types are created by the analysis, every run needs a fresh context.
+    std::unique_ptr<CodeGenContext> context(new CodeGenContext("bench.c", options));
+    runBenchmark("analyzeProgram (per line)", lines, [&root, &context]()
+    {
+        analyzeProgram(*root, *context);
+    }, [&context, &options]()
+    {
+        context.reset(new CodeGenContext("bench.c", options));
+    });
+}
+
+static void benchmarkTypeSystem(CodeGenContext &context)
+{
+    const unsigned Lookups = 1000;
+    TypeSystem &types = context.typeSystem;
+    for (unsigned i = 0; i < 32; i++)
+    {
+        std::string name = "Struct" + std::to_string(i);
+        types.addStructType(name, StructType::create(context.llvmContext, name));
+    }
+
+    std::vector<std::string> builtins = {"int", "double", "char", "bool", "float", "void"};
+    std::vector<std::string> structs;
+    for (unsigned i = 0; i < 32; i += 4)
+    {
+        structs.push_back("Struct" + std::to_string(i));
+    }
+    for (auto *names : {&builtins, &structs})
+    {
+        runBenchmark(names == &builtins ? "getVarType builtin" : "getVarType struct", Lookups, [&]()
+        {
+            for (unsigned i = 0; i < Lookups; i++)
+            {
+                if (!types.getVarType((*names)[i % names->size()]))
+                {
+                    abort();
+                }
+            }
+        });
+    }
+
+    FunctionType *type = FunctionType::get(types.voidTy, false);
+    Function *function = Function::Create(type, GlobalValue::ExternalLinkage, "bench", context.theModule.get());
+    BasicBlock *block = BasicBlock::Create(context.llvmContext, "entry", function);
+    Value *integer = ConstantInt::get(types.intTy, 1);
+    runBenchmark("cast same type", Lookups, [&]()
+    {
+        for (unsigned i = 0; i < Lookups; i++)
+        {
+            types.cast(integer, types.intTy, block);
+        }
+    });
+    runBenchmark("cast int to double", Lookups, [&]()
+    {
+        for (unsigned i = 0; i < Lookups; i++)
+        {
+            types.cast(integer, types.doubleTy, block);
+        }
+    }, [block]()
+    {
+        while (!block->empty())
+        {
+            block->begin()->eraseFromParent();
+        }
+    });
+    function->eraseFromParent();
+}
+
+static void benchmarkJson(const std::string &source)
+{
+    std::shared_ptr<AST_Block> root = parse(source);
+    uint64_t lines = std::count(source.begin(), source.end(), '\n');
+    std::ostringstream os;
+    runBenchmark("writeJson (per line)", lines, [&root, &os]()
+    {
+        JsonWriter writer(os);
+        root->writeJson(writer);
+    }, [&os]()
+    {
+        os.str(std::string());
+    });
+}
+
+/*
+ * Four small analyses for benchmarkVisitors: what a front end collects before
+ * IR generation, cheap enough per node that the walk itself dominates.
+ */
+class NodeCounter : public ASTVisitor<NodeCounter>
+{
+public:
+    uint64_t nodes = 0;
+
+    void enter(const AST_Node &)
+    {
+        nodes++;
+    }
+};
+
+class DepthMeter : public ASTVisitor<DepthMeter>
+{
+public:
+    unsigned depth = 0;
+    unsigned maximumDepth = 0;
+
+    void enter(const AST_Node &)
+    {
+        maximumDepth = std::max(maximumDepth, ++depth);
+    }
+
+    void leave(const AST_Node &)
+    {
+        depth--;
+    }
+};
+
+class KindHistogram : public ASTVisitor<KindHistogram>
+{
+public:
+    uint64_t kinds[256] = {};
+
+    void enter(const AST_Node &node)
+    {
+        kinds[(uint8_t) node.getKind()]++;
+    }
+};
+
+class IdentifierHasher : public ASTVisitor<IdentifierHasher>
+{
+public:
+    uint64_t hash = 0;
+
+    void enter(const AST_Node &node)
+    {
+        if (node.getKind() == ASTKind::Identifier)
+        {
+            hash = hash * 31 + static_cast<const AST_Identifier &>(node).name.size();
+        }
+    }
+};
+
+static void benchmarkVisitors(const std::string &source)
+{
+    std::shared_ptr<AST_Block> root = parse(source);
+    uint64_t lines = std::count(source.begin(), source.end(), '\n');
+    NodeCounter counter;
+    DepthMeter depth;
+    KindHistogram histogram;
+    IdentifierHasher hasher;
+    runBenchmark("4 analyses, 4 walks (per line)", lines, [&]()
+    {
+        counter.walk(*root);
+        depth.walk(*root);
+        histogram.walk(*root);
+        hasher.walk(*root);
+    });
+    runBenchmark("4 analyses, fused walk (per line)", lines, [&]()
+    {
+        fuseVisitors(counter, depth, histogram, hasher).walk(*root);
+    });
+    if (depth.depth != 0 || counter.nodes == 0)
+    {
+        abort();
+    }
+}
+
+static void showHelpInfo()
+{
+    std::cout << "USAGE: slang-microbench [options]\n" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  -filter=<text>             Only run benchmarks whose name contains <text>" << std::endl;
+    std::cout << "  -min-time=<seconds>        Minimum timed duration of every benchmark" << std::endl;
+    std::cout << "  -functions=<n>             Size of the generated input" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    GeneratorOptions generator;
+    generator.functions = 100;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--help") == 0)
+        {
+            showHelpInfo();
+            return EXIT_SUCCESS;
+        } else if (strncmp(argv[i], "-filter=", 8) == 0)
+        {
+            filter = std::string(argv[i] + 8);
+        } else if (strncmp(argv[i], "-min-time=", 10) == 0)
+        {
+            minimumSeconds = atof(argv[i] + 10);
+        } else if (strncmp(argv[i], "-functions=", 11) == 0)
+        {
+            generator.functions = (unsigned) atoi(argv[i] + 11);
+        } else
+        {
+            fprintf(stderr, "slang-microbench:\033[1;31m error:\033[0m unknown argument: '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::string source = generateProgram(generator);
+    // Expression-heavy input for the parser: long chains, shallow blocks.
+    GeneratorOptions expressions = generator;
+    expressions.expressionLength = 48;
+    expressions.depth = 1;
+    std::string expressionSource = generateProgram(expressions);
+
+    printf("%-36s %12s %12s %12s %12s\n", "benchmark", "ns/op", "allocs/op", "bytes/op", "ops");
+    benchmarkLexer(source);
+    benchmarkParser(expressionSource);
+    benchmarkSemanticAnalysis(source);
+
+    Options options;
+    CodeGenContext context("bench.c", options);
+    benchmarkTypeSystem(context);
+
+    benchmarkVisitors(source);
+    benchmarkJson(source);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#!/usr/bin/env bash
+# Compare IR generation from the AST with lowering to the MIR and generating IR
+# from it, on a generated input of array loops calling tiny helpers: the wall
+# time and peak RSS of each phase of -ftime-report, and what the MIR passes did.
+#
+# Usage: bench/mir_codegen.sh <path/to/Slang> [functions] [runs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [functions] [runs]"}
+FUNCTIONS=${2:-2000}
+RUNS=${3:-5}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SRC="$WORK/arrays.c"
+{
+    echo "int table[64];"
+    echo
+    echo "int scale(int x, int y)"
+    echo "{"
+    echo "    return x * 3 + y;"
+    echo "}"
+    echo
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        cat <<SLANG
+int f$f(int a)
+{
+    int m[8][8];
+    int i;
+    int j;
+    int s = 0;
+    for (i = 0; i < 8; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            m[i][j] = scale(i, j) + a;
+        }
+    }
+    for (i = 1; i <= 7; i++)
+    {
+        s = s + m[i][i - 1] + table[i * 8 + $((f % 8))];
+    }
+    return s;
+}
+
+SLANG
+    done
+    echo "int main()"
+    echo "{"
+    echo "    int r = 0;"
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        echo "    r = r + f$f($f);"
+    done
+    echo "    return r;"
+    echo "}"
+} > "$SRC"
+
+echo "input: $(wc -l < "$SRC") lines, $FUNCTIONS functions"
+for flags in "-fmir" "-fbounds-check" "-O1 -fbounds-check"; do
+    "$SLANG" -c $flags -mir-stats "$SRC" -o "$WORK/arrays.o" 2>&1 > /dev/null | sed "s/^/$flags: /"
+done
+
+# Average the wall time and take the peak RSS of the phases of -ftime-report
+# over RUNS compiles.
+run()
+{
+    local name=$1
+    shift
+    for ((i = 0; i < RUNS; i++)); do
+        "$SLANG" -c -ftime-report "$@" "$SRC" -o "$WORK/arrays.o" 2>&1 > /dev/null
+    done | awk -v name="$name" -v runs="$RUNS" '
+        NF >= 5 && $1 ~ /^[0-9.]+$/ {
+            phase = $5; for (i = 6; i <= NF; i++) phase = phase " " $i
+            wall[phase] += $1; if ($4 > rss[phase]) rss[phase] = $4
+        }
+        END {
+            n = split("MIR lowering,MIR passes,IR generation", phases, ",")
+            printf "%-20s", name
+            for (i = 1; i <= n; i++)
+                printf "  %s %8.1f ms %8d KB", phases[i], wall[phases[i]] * 1000 / runs, rss[phases[i]]
+            printf "\n"
+        }'
+}
+
+run ast -O0
+run mir -O0 -fmir
+run mir-bounds-check -O0 -fbounds-check
+run ast-O1 -O1
+run mir-O1 -O1 -fmir
@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+# Speedup of compiling a corpus of inputs in one invocation with -j N over
+# -j 1. The corpus mixes many small files with a few large ones, which is
+# where largest-first scheduling matters.
+#
+# Usage: bench/multi_file.sh <path/to/Slang> [files] [jobs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [files] [jobs]"}
+FILES=${2:-1000}
+JOBS=${3:-$(nproc)}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+for ((f = 0; f < FILES; f++)); do
+    # Every 100th file is 50 times larger.
+    functions=$(( f % 100 == 0 ? 100 : 2 ))
+    for ((g = 0; g < functions; g++)); do
+        cat <<SLANG
+double f${f}_$g(double a, int n)
+{
+    int i;
+    double s = 0.0;
+    for (i = 0; i < n; i++)
+    {
+        s = s * a + i * $g.5;
+    }
+    return s;
+}
+
+SLANG
+    done > "$WORK/f$f.c"
+done
+
+cd "$WORK"
+time_ms()
+{
+    local start=$(date +%s%N)
+    "$SLANG" -c -O2 "$@" f*.c > /dev/null
+    local end=$(date +%s%N)
+    echo "($end - $start) / 1000000" | bc -l
+}
+
+serial=$(time_ms -j 1)
+parallel=$(time_ms -j "$JOBS")
+printf "-j 1   %10.1f ms\n" "$serial"
+printf "-j %-3s %10.1f ms\n" "$JOBS" "$parallel"
+printf "speedup %8.2fx\n" "$(echo "$serial / $parallel" | bc -l)"
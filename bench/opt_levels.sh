@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+# Report compile time per -O level on a large generated input.
+#
+# Usage: bench/opt_levels.sh <path/to/Slang> [functions]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [functions]"}
+FUNCTIONS=${2:-2000}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SRC="$WORK/large.c"
+{
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        cat <<SLANG
+int f$f(int a, int b)
+{
+    int i;
+    int s = 0;
+    for (i = 0; i < a; i++)
+    {
+        s = s + i * b + $f;
+        if (s > 1000)
+        {
+            s = s - a * 3;
+        }
+    }
+    return s;
+}
+
+SLANG
+    done
+    echo "int main()"
+    echo "{"
+    echo "    int r = 0;"
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        echo "    r = r + f$f($f, 3);"
+    done
+    echo "    return r;"
+    echo "}"
+} > "$SRC"
+
+echo "input: $(wc -l < "$SRC") lines, $FUNCTIONS functions"
+for level in -O0 -O1 -O2 -O3; do
+    start=$(date +%s%N)
+    "$SLANG" -c $level "$SRC" -o "$WORK/large.o" > /dev/null
+    end=$(date +%s%N)
+    printf "%-4s %10.1f ms\n" "$level" "$(echo "($end - $start) / 1000000" | bc -l)"
+done
@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+# Code generation wall time against the number of partitions on a large module.
+#
+# Usage: bench/parallel_codegen.sh <path/to/Slang> [functions]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [functions]"}
+FUNCTIONS=${2:-4000}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SRC="$WORK/large.c"
+{
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        cat <<SLANG
+double f$f(double a, int n)
+{
+    int i;
+    double s = 0.0;
+    for (i = 0; i < n; i++)
+    {
+        s = s * a + i * $f.5;
+        if (s > 100000.0)
+        {
+            s = s / 3.0;
+        }
+    }
+    return s;
+}
+
+SLANG
+    done
+    echo "int main()"
+    echo "{"
+    echo "    f0(1.5, 10);"
+    echo "    return 0;"
+    echo "}"
+} > "$SRC"
+
+for partitions in 1 2 4 8 16; do
+    start=$(date +%s%N)
+    "$SLANG" -c -O2 -fcodegen-partitions=$partitions "$SRC" -o "$WORK/large.o" > /dev/null
+    end=$(date +%s%N)
+    printf "%-3s partitions %10.1f ms\n" "$partitions" "$(echo "($end - $start) / 1000000" | bc -l)"
+done
@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+# Optimization scaling with -j: compile a module with many independent
+# functions at 1..32 threads and check that the output does not change. Every
+# -j gives the same output, but not the output without -j: the parallel
+# pipeline runs the IPO cleanup per partition, see Optimizer::optimize. Exits
+# with 1 if any -j output differs from -j 1.
+#
+# Usage: bench/parallel_opt.sh <path/to/Slang> [functions]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [functions]"}
+FUNCTIONS=${2:-4000}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SRC="$WORK/functions.c"
+{
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        cat <<SLANG
+int f$f(int a, int b)
+{
+    int i;
+    int j;
+    int s = 0;
+    for (i = 0; i < a; i++)
+    {
+        for (j = 0; j < b; j++)
+        {
+            s = s + i * j + $f;
+        }
+    }
+    return s;
+}
+
+SLANG
+    done
+    echo "int main()"
+    echo "{"
+    echo "    return f0(3, 4);"
+    echo "}"
+} > "$SRC"
+
+"$SLANG" -S -emit-llvm -O2 "$SRC" -o "$WORK/serial.ll" > /dev/null
+"$SLANG" -S -emit-llvm -O2 -j 1 "$SRC" -o "$WORK/reference.ll" > /dev/null
+if cmp -s "$WORK/serial.ll" "$WORK/reference.ll"; then same=yes; else same=no; fi
+echo "serial and -j1 identical=$same (not required)"
+status=0
+for threads in 1 2 4 8 16 32; do
+    start=$(date +%s%N)
+    "$SLANG" -S -emit-llvm -O2 -j $threads "$SRC" -o "$WORK/j$threads.ll" > /dev/null
+    end=$(date +%s%N)
+    if cmp -s "$WORK/reference.ll" "$WORK/j$threads.ll"; then same=yes; else same=NO; status=1; fi
+    printf "%-4s %10.1f ms  identical=%s\n" "-j$threads" "$(echo "($end - $start) / 1000000" | bc -l)" "$same"
+done
+exit $status
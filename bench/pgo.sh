@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+# Profile-guided optimization: train an instrumented build, merge the raw
+# profile offline and compare the plain and the profile-optimized builds.
+#
+# Usage: bench/pgo.sh <path/to/Slang> [kernel.c] [runs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [kernel.c] [runs]"}
+KERNEL=${2:-$(dirname "$0")/kernels/branchy.c}
+RUNS=${3:-5}
+PROFDATA=${LLVM_PROFDATA:-llvm-profdata}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+timed()
+{
+    local name=$1
+    local start=$(date +%s%N)
+    for ((i = 0; i < RUNS; i++)); do
+        "$WORK/$name" > /dev/null
+    done
+    local end=$(date +%s%N)
+    printf "%-12s %10.1f ms/run\n" "$name" "$(echo "($end - $start) / $RUNS / 1000000" | bc -l)"
+}
+
+"$SLANG" -O2 "$KERNEL" -o "$WORK/plain" > /dev/null
+"$SLANG" -O2 -fprofile-generate="$WORK/raw" "$KERNEL" -o "$WORK/instrumented" > /dev/null
+"$WORK/instrumented" > /dev/null
+"$PROFDATA" merge -o "$WORK/kernel.profdata" "$WORK"/raw/*.profraw
+"$SLANG" -O2 -fprofile-use="$WORK/kernel.profdata" "$KERNEL" -o "$WORK/pgo" > /dev/null
+
+timed plain
+timed pgo
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <vector>
+#include <sys/resource.h>
+#include <json/json.h>
+#include "absyn.h"
+#include "ast_binary.h"
+#include "compiler.h"
+#include "generator.h"
+#include "time_report.h"
+
+/*
+ * slang-bench: compile a generated program in-process and report lines per
+ * second and peak RSS for every compiler phase, as JSON for bench/compare.py.
+ * Also checks that the AST survives a round trip through -emit-ast, and
+ * compares the size and speed of that format with the JSON export.
+ */
+
+static void showHelpInfo()
+{
+    std::cout << "USAGE: slang-bench [options]\n" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  -seed=<n>                  Seed of the program generator" << std::endl;
+    std::cout << "  -functions=<n>             Functions in the program" << std::endl;
+    std::cout << "  -depth=<n>                 Block nesting in every function" << std::endl;
+    std::cout << "  -statements=<n>            Statements per block" << std::endl;
+    std::cout << "  -expression-length=<n>     Operands per expression" << std::endl;
+    std::cout << "  -array-size=<n>            Elements of every function's array initializer" << std::endl;
+    std::cout << "  -structs=<n>               Struct types in the program" << std::endl;
+    std::cout << "  -O<level>                  Optimization level of the compiles" << std::endl;
+    std::cout << "  -repetitions=<n>           Timed compiles, the median is reported" << std::endl;
+    std::cout << "  -emit-source=<file>        Write the program to <file> and exit" << std::endl;
+    std::cout << "  -o <file>                  Write the results to <file> instead of stdout" << std::endl;
+}
+
+static double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+static Json::Value measurement(double wall, long peakRSS, size_t lines)
+{
+    Json::Value value;
+    value["wall_seconds"] = wall;
+    value["lines_per_second"] = wall > 0 ? lines / wall : 0.0;
+    value["peak_rss_kb"] = (Json::Int64) peakRSS;
+    return value;
+}
+
+/*
+ * medianSeconds: median wall time of repetitions calls of body.
+ */
+static double medianSeconds(unsigned repetitions, const std::function<void()> &body)
+{
+    std::vector<double> walls;
+    for (unsigned r = 0; r < repetitions; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        walls.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    return median(walls);
+}
+
+static std::string toJson(const AST_Block &block)
+{
+    std::ostringstream os;
+    JsonWriter writer(os);
+    block.writeJson(writer);
+    writer.flush();
+    return os.str();
+}
+
+/*
+ * compareASTFormats: size and speed of the JSON export against -emit-ast,
+ * after checking that the parser's AST survives a round trip through the
+ * latter unchanged.
+ * @return false if it doesn't.
+ */
+static bool compareASTFormats(const std::shared_ptr<AST_Block> &ast, unsigned repetitions, Json::Value &value)
+{
+    std::string binary = writeASTBinary(ast);
+    ASTReader reader(binary.data(), binary.size());
+    std::shared_ptr<AST_Block> reloaded = reader.readProgram();
+    if (!reloaded || writeASTBinary(reloaded) != binary || toJson(*reloaded) != toJson(*ast))
+    {
+        fprintf(stderr, "slang-bench:\033[1;31m error:\033[0m the AST changes in a round trip through -emit-ast\n");
+        return false;
+    }
+
+    std::string json = toJson(*ast);
+    value["json_bytes"] = (Json::UInt64) json.size();
+    value["json_write_seconds"] = medianSeconds(repetitions, [&ast]()
+    {
+        toJson(*ast);
+    });
+    value["binary_bytes"] = (Json::UInt64) binary.size();
+    value["binary_write_seconds"] = medianSeconds(repetitions, [&ast]()
+    {
+        writeASTBinary(ast);
+    });
+    value["binary_read_seconds"] = medianSeconds(repetitions, [&binary]()
+    {
+        ASTReader reader(binary.data(), binary.size());
+        reader.readProgram();
+    });
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    GeneratorOptions generator;
+    Options options;
+    unsigned repetitions = 5;
+    std::string sourceFile;
+    std::string resultFile;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--help") == 0)
+        {
+            showHelpInfo();
+            return EXIT_SUCCESS;
+        } else if (strncmp(argv[i], "-seed=", 6) == 0)
+        {
+            generator.seed = strtoull(argv[i] + 6, nullptr, 10);
+        } else if (strncmp(argv[i], "-functions=", 11) == 0)
+        {
+            generator.functions = (unsigned) atoi(argv[i] + 11);
+        } else if (strncmp(argv[i], "-depth=", 7) == 0)
+        {
+            generator.depth = (unsigned) atoi(argv[i] + 7);
+        } else if (strncmp(argv[i], "-statements=", 12) == 0)
+        {
+            generator.statements = (unsigned) std::max(1, atoi(argv[i] + 12));
+        } else if (strncmp(argv[i], "-expression-length=", 19) == 0)
+        {
+            generator.expressionLength = (unsigned) std::max(1, atoi(argv[i] + 19));
+        } else if (strncmp(argv[i], "-array-size=", 12) == 0)
+        {
+            generator.arraySize = (unsigned) atoi(argv[i] + 12);
+        } else if (strncmp(argv[i], "-structs=", 9) == 0)
+        {
+            generator.structs = (unsigned) atoi(argv[i] + 9);
+        } else if (argv[i][0] == '-' && argv[i][1] == 'O')
+        {
+            options.OptimizationLevel = std::string(argv[i]);
+        } else if (strncmp(argv[i], "-repetitions=", 13) == 0)
+        {
+            repetitions = (unsigned) std::max(1, atoi(argv[i] + 13));
+        } else if (strncmp(argv[i], "-emit-source=", 13) == 0)
+        {
+            sourceFile = std::string(argv[i] + 13);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            resultFile = std::string(argv[++i]);
+        } else
+        {
+            fprintf(stderr, "slang-bench:\033[1;31m error:\033[0m unknown argument: '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::string source = generateProgram(generator);
+    size_t lines = std::count(source.begin(), source.end(), '\n');
+    if (!sourceFile.empty())
+    {
+        std::ofstream os(sourceFile);
+        os << source;
+        return os.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    options.InputName = "bench.c";
+    CompilerInstance compiler;
+    // Untimed: registers the target and faults in the compiler's code.
+    CompileResult warmup = compiler.compile(source, options);
+    if (!warmup.success)
+    {
+        fprintf(stderr, "%s", warmup.diagnostics.c_str());
+        fprintf(stderr, "slang-bench:\033[1;31m error:\033[0m the generated program does not compile\n");
+        return EXIT_FAILURE;
+    }
+
+    startTimeReport(false, true);
+    std::vector<std::string> phaseOrder;
+    std::map<std::string, std::vector<double>> phaseWalls;
+    std::map<std::string, long> phasePeaks;
+    std::vector<double> totalWalls;
+    for (unsigned r = 0; r < repetitions; r++)
+    {
+        clearTimeReport();
+        auto start = std::chrono::steady_clock::now();
+        CompileResult result = compiler.compile(source, options);
+        auto end = std::chrono::steady_clock::now();
+        totalWalls.push_back(std::chrono::duration<double>(end - start).count());
+
+        for (auto &phase : collectPhaseTimes())
+        {
+            if (phaseWalls.find(phase.phase) == phaseWalls.end())
+            {
+                phaseOrder.push_back(phase.phase);
+            }
+            phaseWalls[phase.phase].push_back(phase.wall);
+            phasePeaks[phase.phase] = std::max(phasePeaks[phase.phase], phase.peakRSS);
+        }
+    }
+
+    Json::Value root;
+    Json::Value &program = root["program"];
+    program["seed"] = (Json::UInt64) generator.seed;
+    program["functions"] = generator.functions;
+    program["depth"] = generator.depth;
+    program["statements"] = generator.statements;
+    program["expression_length"] = generator.expressionLength;
+    program["array_size"] = generator.arraySize;
+    program["structs"] = generator.structs;
+    program["lines"] = (Json::UInt64) lines;
+    program["bytes"] = (Json::UInt64) source.size();
+    root["optimization_level"] = options.OptimizationLevel;
+    root["repetitions"] = repetitions;
+
+    Json::Value &phases = root["phases"];
+    phases = Json::Value(Json::arrayValue);
+    for (auto &name : phaseOrder)
+    {
+        Json::Value phase = measurement(median(phaseWalls[name]), phasePeaks[name], lines);
+        phase["name"] = name;
+        phases.append(phase);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    root["total"] = measurement(median(totalWalls), usage.ru_maxrss, lines);
+
+    // Against "Lex+parse" in phases: what reading an AST saves over parsing the source.
+    if (!compareASTFormats(warmup.ast, repetitions, root["ast"]))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (resultFile.empty())
+    {
+        std::cout << root;
+        return EXIT_SUCCESS;
+    }
+    std::ofstream os(resultFile);
+    os << root;
+    return os.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,79 @@
+#!/usr/bin/env bash
+# Compare the time IR generation spends on a struct- and name-heavy input
+# between two builds of Slang, e.g. before and after a front-end change. The
+# semantic analysis that resolves names ahead of IR generation is reported
+# separately; the baseline may not have it.
+#
+# Usage: bench/struct_codegen.sh <path/to/baseline/Slang> <path/to/Slang> [functions] [runs]
+
+set -e
+
+BASELINE=${1:?"usage: $0 <path/to/baseline/Slang> <path/to/Slang> [functions] [runs]"}
+SLANG=${2:?"usage: $0 <path/to/baseline/Slang> <path/to/Slang> [functions] [runs]"}
+FUNCTIONS=${3:-2000}
+RUNS=${4:-5}
+STRUCTS=16
+MEMBERS=12
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SRC="$WORK/structs.c"
+{
+    for ((s = 0; s < STRUCTS; s++)); do
+        echo "struct S$s"
+        echo "{"
+        for ((m = 0; m < MEMBERS; m++)); do
+            echo "    int member$m;"
+        done
+        echo "};"
+        echo
+    done
+    for ((f = 0; f < FUNCTIONS; f++)); do
+        s=$((f % STRUCTS))
+        cat <<SLANG
+int f$f(int a, int b)
+{
+    struct S$s v;
+    struct S$(((f + 1) % STRUCTS)) w;
+    int i;
+    int total = 0;
+SLANG
+        for ((m = 0; m < MEMBERS; m++)); do
+            echo "    v.member$m = a + $m;"
+            echo "    w.member$m = b - $m;"
+        done
+        echo "    for (i = 0; i < a; i++)"
+        echo "    {"
+        for ((m = 0; m < MEMBERS; m++)); do
+            echo "        total = total + v.member$m * w.member$(((m + 5) % MEMBERS));"
+        done
+        echo "    }"
+        echo "    return total;"
+        echo "}"
+        echo
+    done
+    echo "int main()"
+    echo "{"
+    echo "    return f0(1, 2);"
+    echo "}"
+} > "$SRC"
+
+echo "input: $(wc -l < "$SRC") lines, $FUNCTIONS functions, $STRUCTS structs of $MEMBERS members"
+
+# Sum the wall time of a phase of -ftime-report over RUNS compiles.
+phase()
+{
+    local slang=$1 name=$2
+    for ((i = 0; i < RUNS; i++)); do
+        "$slang" -c -O0 -ftime-report "$SRC" -o "$WORK/structs.o" 2>&1 > /dev/null
+    done | awk -v name="$name" '
+        { phase = $5; for (i = 6; i <= NF; i++) phase = phase " " $i }
+        phase == name { total += $1 }
+        END { printf "%10.1f ms", total * 1000 / '"$RUNS"' }'
+}
+
+for build in baseline new; do
+    slang=$([ $build = baseline ] && echo "$BASELINE" || echo "$SLANG")
+    printf "%-10s IR generation %s   semantic analysis %s\n" "$build" \
+        "$(phase "$slang" "IR generation")" "$(phase "$slang" "Semantic analysis")"
+done
@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+# ThinLTO against separate compilation on a program whose hot calls cross
+# module boundaries. Reports link time and run time of both builds.
+#
+# Usage: bench/thinlto.sh <path/to/Slang> [runs]
+
+set -e
+
+SLANG=${1:?"usage: $0 <path/to/Slang> [runs]"}
+RUNS=${2:-5}
+KERNELS=$(dirname "$0")/kernels
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+ms()
+{
+    echo "($2 - $1) / 1000000" | bc -l
+}
+
+build()
+{
+    local name=$1
+    shift
+    "$SLANG" -c -O2 "$@" "$KERNELS/lto_main.c" -o "$WORK/$name-main.o" > /dev/null
+    "$SLANG" -c -O2 "$@" "$KERNELS/lto_lib.c" -o "$WORK/$name-lib.o" > /dev/null
+    local start=$(date +%s%N)
+    "$SLANG" -O2 "$@" "$WORK/$name-main.o" "$WORK/$name-lib.o" -o "$WORK/$name" > /dev/null
+    local linked=$(date +%s%N)
+    for ((i = 0; i < RUNS; i++)); do
+        "$WORK/$name" > /dev/null
+    done
+    local end=$(date +%s%N)
+    printf "%-8s link %8.1f ms   run %8.1f ms/run\n" "$name" "$(ms $start $linked)" \
+        "$(echo "$(ms $linked $end) / $RUNS" | bc -l)"
+}
+
+build nolto
+build thinlto -flto=thin
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#include "build_id.h"
+#include "cache.h"
+#include "remarks.h"
+#include "target_gen.h"
+
+using namespace llvm;
+
+static const char *EntryPrefix = "llvmcache-";
+
+/*
+ * appendStats: add one line to the stats log. Lines are written with a single
+ * O_APPEND write, so concurrent processes don't interleave them.
+ */
+static void appendStats(const Options &options, const char *event, uint64_t bytes)
+{
+    SmallString<128> path(options.CacheDir);
+    sys::path::append(path, "stats.log");
+    std::error_code EC;
+    raw_fd_ostream OS(path, EC, sys::fs::F_Append | sys::fs::F_Text);
+    if (!EC)
+    {
+        OS << event << " " << bytes << "\n";
+    }
+}
+
+static std::string entryPath(const Options &options, const std::string &key)
+{
+    SmallString<128> path(options.CacheDir);
+    sys::path::append(path, EntryPrefix + key);
+    return path.str().str();
+}
+
+bool cacheEnabled(const Options &options)
+{
+    return !options.CacheDir.empty() && !options.SaveTemps && !remarksRequested(options) && !options.EmitAST &&
+           !options.DumpMIR && !options.MIRStats && !options.FoldASTStats;
+}
+
+std::string computeCacheKey(const Options &options, const std::string &source)
+{
+    SHA1 hasher;
+    auto field = [&hasher](StringRef value)
+    {
+        // Length-prefixed, so that adjacent fields can't run into each other.
+        hasher.update(utostr(value.size()));
+        hasher.update(":");
+        hasher.update(value);
+    };
+
+    // The compiler build: a change to any of its sources or to LLVM starts over with a cold cache.
+    field(SLANG_BUILD_ID);
+    field(LLVM_VERSION_STRING);
+
+    field(options.InputName);
+    field(source);
+
+    field(getTargetTriple(options));
+    field(getCPUStr(options));
+    field(getFeaturesStr(options));
+
+    field(options.OptimizationLevel);
+    field(options.FoldAST ? "" : "no-ast-fold");
+    field(options.MIR ? (options.BoundsCheck ? "mir-bounds-check" : "mir") : "");
+    field(options.EmitIR ? "ir" : options.EmitBC ? "bc" : options.EmitASM ? "asm" : "obj");
+    field(options.ThinLTO ? "thinlto" : "");
+    field(utostr(options.CodeGenPartitions));
+    field(options.ProfileGenerate ? "profile-generate=" + options.ProfileGenerateDir : "");
+    if (!options.ProfileUseFile.empty())
+    {
+        // The profile's contents steer the optimizer, not its name.
+        auto BufferOrErr = MemoryBuffer::getFile(options.ProfileUseFile);
+        field(BufferOrErr ? (*BufferOrErr)->getBuffer() : StringRef(options.ProfileUseFile));
+    }
+
+    return toHex(hasher.result());
+}
+
+bool lookupCache(const Options &options, const std::string &key, std::string &output)
+{
+    std::string entry = entryPath(options, key);
+    // Entries are only ever renamed into place, an entry that opens is complete.
+    int FD;
+    if (sys::fs::openFileForRead(entry, FD))
+    {
+        appendStats(options, "miss", 0);
+        return false;
+    }
+    // The modification time is the LRU clock, see storeCache().
+    sys::fs::setLastModificationAndAccessTime(FD, std::chrono::system_clock::now());
+    sys::fs::file_status status;
+    sys::fs::status(FD, status);
+    // Read through the descriptor: an eviction in between only unlinks the name.
+    auto BufferOrErr = MemoryBuffer::getOpenFile(FD, entry, status.getSize(), false);
+    close(FD);
+
+    if (!BufferOrErr)
+    {
+        appendStats(options, "miss", 0);
+        return false;
+    }
+    output = (*BufferOrErr)->getBuffer().str();
+    appendStats(options, "hit", output.size());
+    return true;
+}
+
+/*
+ * pruneCache: remove the least recently used entries until the cache fits.
+ */
+static void pruneCache(const Options &options)
+{
+    struct Entry
+    {
+        std::string path;
+        uint64_t size;
+        sys::TimePoint<> used;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+
+    std::error_code EC;
+    for (sys::fs::directory_iterator it(options.CacheDir, EC), end; it != end && !EC; it.increment(EC))
+    {
+        if (!sys::path::filename(it->path()).startswith(EntryPrefix))
+        {
+            continue;
+        }
+        sys::fs::file_status status;
+        if (sys::fs::status(it->path(), status))
+        {
+            continue;
+        }
+        entries.push_back({it->path(), status.getSize(), status.getLastModificationTime()});
+        total += status.getSize();
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+    {
+        return a.used < b.used;
+    });
+    for (auto &entry : entries)
+    {
+        if (total <= options.CacheMaxSize)
+        {
+            break;
+        }
+        // Readers that already opened the entry keep their copy.
+        sys::fs::remove(entry.path);
+        total -= entry.size;
+    }
+}
+
+void storeCache(const Options &options, const std::string &key, const std::string &output)
+{
+    if (sys::fs::create_directories(options.CacheDir))
+    {
+        return;
+    }
+
+    // Write to a private file, then rename it over the entry: readers see all of it or nothing.
+    SmallString<128> model(options.CacheDir);
+    sys::path::append(model, "tmp-%%%%%%%%%%%%");
+    int FD;
+    SmallString<128> temporary;
+    if (sys::fs::createUniqueFile(model, FD, temporary))
+    {
+        return;
+    }
+    bool failed;
+    {
+        raw_fd_ostream OS(FD, true);
+        OS << output;
+        OS.close();
+        failed = OS.has_error();
+        OS.clear_error();
+    }
+    if (failed || sys::fs::rename(temporary, entryPath(options, key)))
+    {
+        sys::fs::remove(temporary);
+        return;
+    }
+
+    pruneCache(options);
+}
+
+void printCacheStats(const Options &options)
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t saved = 0;
+
+    SmallString<128> path(options.CacheDir);
+    sys::path::append(path, "stats.log");
+    std::ifstream log(path.str().str());
+    std::string event;
+    uint64_t bytes;
+    while (log >> event >> bytes)
+    {
+        if (event == "hit")
+        {
+            hits++;
+            saved += bytes;
+        } else
+        {
+            misses++;
+        }
+    }
+
+    uint64_t entries = 0;
+    uint64_t size = 0;
+    std::error_code EC;
+    for (sys::fs::directory_iterator it(options.CacheDir, EC), end; it != end && !EC; it.increment(EC))
+    {
+        sys::fs::file_status status;
+        if (sys::path::filename(it->path()).startswith(EntryPrefix) && !sys::fs::status(it->path(), status))
+        {
+            entries++;
+            size += status.getSize();
+        }
+    }
+
+    uint64_t lookups = hits + misses;
+    std::cout << "Cache directory: " << options.CacheDir << std::endl;
+    std::cout << "Entries:         " << entries << " (" << size << " of " << options.CacheMaxSize << " bytes)" << std::endl;
+    std::cout << "Hits:            " << hits << std::endl;
+    std::cout << "Misses:          " << misses << std::endl;
+    std::cout << "Hit rate:        " << (lookups ? 100.0 * hits / lookups : 0.0) << "%" << std::endl;
+    std::cout << "Bytes saved:     " << saved << std::endl;
+}
@@ -0,0 +1,47 @@
+#ifndef SLANG_CACHE_H
+#define SLANG_CACHE_H
+
+#include <string>
+#include "options.h"
+
+/*
+ * Content-addressed cache of compiled outputs, turned on by -fcache-dir.
+ * An entry is named llvmcache-<key>, where the key hashes everything that
+ * affects the output, so an entry never has to be invalidated.
+ */
+
+/*
+ * cacheEnabled: whether outputs are looked up in and stored to the cache.
+ * Compiles with side outputs (-save-temps, remarks, -dump-mir and the
+ * -mir-stats and -ast-fold-stats remarks) always run.
+ */
+bool cacheEnabled(const Options &options);
+
+/*
+ * computeCacheKey: SHA1 of the source, the compiler build, the target triple,
+ * CPU and features, and all options that change the output.
+ * The input name counts too, it is recorded in the object's symbol table.
+ * @param source -- the source text.
+ */
+std::string computeCacheKey(const Options &options, const std::string &source);
+
+/*
+ * lookupCache: read the entry for key into output and mark it recently used.
+ * @return false on a miss, output is left alone then.
+ */
+bool lookupCache(const Options &options, const std::string &key, std::string &output);
+
+/*
+ * storeCache: publish output as the entry for key, then evict the least
+ * recently used entries until the cache fits in -fcache-max-size.
+ * Safe against other processes storing or reading the same entry.
+ */
+void storeCache(const Options &options, const std::string &key, const std::string &output);
+
+/*
+ * printCacheStats: hits, misses and bytes saved over all processes that used
+ * the cache, and its current size.
+ */
+void printCacheStats(const Options &options);
+
+#endif //SLANG_CACHE_H
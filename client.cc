@@ -0,0 +1,52 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "daemon.h"
+
+#ifndef SLANG_COMPILER_NAME
+#define SLANG_COMPILER_NAME "Slang"
+#endif
+
+/*
+ * slang-client: drop-in replacement for the slang command line that hands the
+ * compile to a running 'Slang -daemon'. Without a daemon it runs the compiler
+ * itself, $SLANG_COMPILER or the Slang next to this executable.
+ */
+int main(int argc, char **argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int status;
+    if (sendRequest(defaultSocketPath(), args, status))
+    {
+        return status;
+    }
+
+    std::string compiler;
+    const char *env = getenv("SLANG_COMPILER");
+    if (env && *env)
+    {
+        compiler = env;
+    } else
+    {
+        char self[4096];
+        ssize_t length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+        if (length > 0)
+        {
+            self[length] = '\0';
+            char *slash = strrchr(self, '/');
+            compiler = std::string(self, slash ? slash + 1 : self) + SLANG_COMPILER_NAME;
+        } else
+        {
+            compiler = SLANG_COMPILER_NAME;
+        }
+    }
+
+    argv[0] = const_cast<char *>(compiler.c_str());
+    execvp(argv[0], argv);
+    fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot run '%s': %s\n", compiler.c_str(), strerror(errno));
+    return EXIT_FAILURE;
+}
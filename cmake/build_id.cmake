@@ -0,0 +1,11 @@
+# Writes OUTPUT, a header defining SLANG_BUILD_ID: a hash of the files listed
+# in SOURCES, separated by '|'. cache.cc keys the cached outputs on it, so a
+# change to any source of the compiler starts over with a cold cache.
+string(REPLACE "|" ";" SOURCES "${SOURCES}")
+set(HASHES "")
+foreach (SOURCE ${SOURCES})
+    file(SHA1 ${SOURCE} HASH)
+    string(APPEND HASHES "${SOURCE} ${HASH}\n")
+endforeach ()
+string(SHA1 BUILD_ID "${HASHES}")
+file(WRITE ${OUTPUT} "#define SLANG_BUILD_ID \"${BUILD_ID}\"\n")
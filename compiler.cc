@@ -0,0 +1,173 @@
+#include <sstream>
+#include "IR.h"
+#include "absyn.h"
+#include "ast_binary.h"
+#include "cache.h"
+#include "compiler.h"
+#include "diagnostics.h"
+#include "fold.h"
+#include "optimize.h"
+#include "parser_state.h"
+#include "remarks.h"
+#include "target_gen.h"
+#include "time_report.h"
+#include "debug.h"
+
+/*
+ * generateProgram: everything after parsing, from result.ast to result.outputs.
+ * @param cacheKey -- where to store the output, empty to not cache it.
+ */
+static void generateProgram(CompileResult &result, const Options &options, const std::string &cacheKey)
+{
+#ifdef AST_DEBUG
+    std::cout << result.ast << std::endl;
+    result.ast->print("--");
+#endif
+
+    if (options.FoldAST)
+    {
+        size_t nodes = options.FoldASTStats ? countASTNodes(result.ast.get()) : 0;
+        FoldStatistics statistics;
+        {
+            TimeRegion region("AST folding");
+            statistics = foldAST(*result.ast);
+        }
+        if (options.FoldASTStats)
+        {
+            nodes -= countASTNodes(result.ast.get());
+            reportDiagnostic("\033[1m%s:\033[1;34m remark: \033[0m%zu AST nodes eliminated, %u constants folded, "
+                             "%u identities, %u dead branches [-ast-fold-stats]\n", diagnosticFile(), nodes,
+                             statistics.folded, statistics.identities, statistics.deadBranches);
+        }
+    }
+
+    CodeGenContext context(options.InputName, options);
+    if (parseOptimizationLevel(options.OptimizationLevel) == 0 && !options.EmitIR)
+    {
+        // Nobody reads local value names in an -O0 object file, skip building them.
+        context.llvmContext.setDiscardValueNames(true);
+    }
+    if (remarksRequested(options) && !setupRemarks(context))
+    {
+        return;
+    }
+    // Target first, so that IR generation and optimization see the real DataLayout and TTI.
+    initializeTarget(context);
+    context.generateCode(*result.ast);
+    result.mirDump = std::move(context.mirDump);
+    if (errorCount() > 0)
+    {
+        reportDiagnostic("%d errors generated.\n", errorCount());
+        return;
+    }
+
+    {
+        TimeRegion region("Code generation");
+        if (!generateTarget(context, result))
+        {
+            return;
+        }
+    }
+    if (context.optimizationRecordStream)
+    {
+        context.optimizationRecordStream->flush();
+        result.optimizationRecord = context.optimizationRecord;
+    }
+    // Partitioned objects that are linked directly are not worth an entry each.
+    if (!cacheKey.empty() && result.outputs.size() == 1)
+    {
+        storeCache(options, cacheKey, result.outputs.front());
+    }
+    result.success = true;
+}
+
+CompileResult CompilerInstance::compile(const std::string &source, const Options &options) const
+{
+    CompileResult result;
+    DiagnosticScope diagnostics(&result.diagnostics, options.InputName.c_str());
+
+    std::string cacheKey;
+    if (cacheEnabled(options))
+    {
+        TimeRegion region("Cache lookup");
+        cacheKey = computeCacheKey(options, source);
+        std::string output;
+        if (lookupCache(options, cacheKey, output))
+        {
+            result.outputs.push_back(std::move(output));
+            result.success = true;
+            return result;
+        }
+    }
+
+    ParserState state;
+    std::istringstream input(source);
+    state.input = &input;
+    state.filename = options.InputName.c_str();
+    {
+        // The grammar actions build the AST, so this covers lexing, parsing and AST construction.
+        TimeRegion region("Lex+parse");
+        if (!parseProgram(state))
+        {
+            reportDiagnostic("%d errors generated.\n", state.errors);
+            return result;
+        }
+    }
+    result.ast = state.programBlock;
+    if (options.EmitAST)
+    {
+        result.outputs.push_back(writeASTBinary(result.ast));
+        result.success = true;
+        return result;
+    }
+    if (state.emptyFile)
+    {
+        result.success = true;
+        return result;
+    }
+    generateProgram(result, options, cacheKey);
+    return result;
+}
+
+CompileResult CompilerInstance::compileAST(const char *data, size_t size, const Options &options) const
+{
+    CompileResult result;
+    DiagnosticScope diagnostics(&result.diagnostics, options.InputName.c_str());
+
+    std::string cacheKey;
+    if (cacheEnabled(options))
+    {
+        TimeRegion region("Cache lookup");
+        cacheKey = computeCacheKey(options, std::string(data, size));
+        std::string output;
+        if (lookupCache(options, cacheKey, output))
+        {
+            result.outputs.push_back(std::move(output));
+            result.success = true;
+            return result;
+        }
+    }
+
+    {
+        TimeRegion region("AST read");
+        ASTReader reader(data, size);
+        result.ast = reader.readProgram();
+    }
+    if (!result.ast)
+    {
+        return result;
+    }
+    if (options.EmitAST)
+    {
+        result.outputs.push_back(std::string(data, size));
+        result.success = true;
+        return result;
+    }
+    if (result.ast->statements->empty())
+    {
+        result.success = true;
+        return result;
+    }
+    generateProgram(result, options, cacheKey);
+    return result;
+}
@@ -0,0 +1,58 @@
+#ifndef SLANG_COMPILER_H
+#define SLANG_COMPILER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "options.h"
+
+class AST_Block;
+
+/*
+ * CompileResult: everything one compile produced, in memory. Nothing is
+ * written to disk or printed, that is up to the caller.
+ */
+struct CompileResult
+{
+    bool success = false;
+    // The requested output: textual IR, bitcode, assembly, object code or the serialized AST.
+    // Partitioned code generation (-fcodegen-partitions) gives one object per partition.
+    std::vector<std::string> outputs;
+    // -save-temps: the optimized module as textual IR, bitcode and assembly.
+    std::string savedIR;
+    std::string savedBitcode;
+    std::string savedAssembly;
+    // -fsave-optimization-record: the remarks as YAML.
+    std::string optimizationRecord;
+    // -dump-mir: the text form of the MIR, empty if the program was not lowered.
+    std::string mirDump;
+    // Errors, warnings and remarks, formatted as the command line prints them.
+    std::string diagnostics;
+    // The parsed program, nullptr for an empty input or a cache hit.
+    std::shared_ptr<AST_Block> ast;
+};
+
+/*
+ * CompilerInstance: the Slang compiler as a library. A compile keeps all its
+ * state to itself, so one instance, or several, may compile on any number of
+ * threads at once.
+ */
+class CompilerInstance
+{
+public:
+    /*
+     * compile: compile one translation unit.
+     * @param source -- the source text, options.InputName names it in diagnostics.
+     * @param options -- what to produce and for which target.
+     */
+    CompileResult compile(const std::string &source, const Options &options) const;
+
+    /*
+     * compileAST: compile a translation unit saved by -emit-ast, without the
+     * scanner and parser. The data is only read during the call, so it may be
+     * an mmap'd file.
+     */
+    CompileResult compileAST(const char *data, size_t size, const Options &options) const;
+};
+
+#endif //SLANG_COMPILER_H
@@ -0,0 +1,364 @@
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "daemon.h"
+
+// The client's stdin, stdout and stderr.
+static const int StreamCount = 3;
+
+std::string defaultSocketPath()
+{
+    const char *path = getenv("SLANG_DAEMON_SOCKET");
+    if (path && *path)
+    {
+        return path;
+    }
+    const char *runtimeDir = getenv("XDG_RUNTIME_DIR");
+    if (runtimeDir && *runtimeDir)
+    {
+        return std::string(runtimeDir) + "/slang.sock";
+    }
+    return "/tmp/slang-" + std::to_string(getuid()) + "/daemon.sock";
+}
+
+/*
+ * isPrivateDirectory: whether the directory of socketPath is ours and nobody
+ * else can create, replace or remove a socket in it.
+ */
+static bool isPrivateDirectory(const std::string &socketPath)
+{
+    size_t slash = socketPath.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : socketPath.substr(0, slash);
+    struct stat info;
+    return lstat(directory.c_str(), &info) == 0 && S_ISDIR(info.st_mode) && info.st_uid == getuid() &&
+           (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/*
+ * makePrivateDirectory: create the directory of socketPath readable by us
+ * only if it does not exist, and check that it is private.
+ */
+static bool makePrivateDirectory(const std::string &socketPath)
+{
+    size_t slash = socketPath.rfind('/');
+    if (slash != std::string::npos && slash > 0)
+    {
+        mkdir(socketPath.substr(0, slash).c_str(), S_IRWXU);
+    }
+    if (!isPrivateDirectory(socketPath))
+    {
+        fprintf(stderr, "slang:\033[1;31m error:\033[0m the directory of '%s' must be owned by you and writable by "
+                        "no one else\n", socketPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*
+ * peerIsUs: whether the process at the other end of socket runs as our user.
+ */
+static bool peerIsUs(int socket)
+{
+    struct ucred credentials;
+    socklen_t size = sizeof(credentials);
+    return getsockopt(socket, SOL_SOCKET, SO_PEERCRED, &credentials, &size) == 0 && credentials.uid == getuid();
+}
+
+static bool makeAddress(const std::string &socketPath, struct sockaddr_un &address)
+{
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "slang:\033[1;31m error:\033[0m socket path too long: '%s'\n", socketPath.c_str());
+        return false;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+    return true;
+}
+
+static bool readAll(int fd, void *data, size_t size)
+{
+    char *p = static_cast<char *>(data);
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+/*
+ * Wire format of a request: a uint32 payload length sent together with the
+ * stream descriptors, then the payload "cwd\0arg1\0arg2\0...". The reply is
+ * an int32 exit status.
+ */
+bool sendRequest(const std::string &socketPath, const std::vector<std::string> &args, int &status)
+{
+    struct sockaddr_un address;
+    if (!makeAddress(socketPath, address))
+    {
+        return false;
+    }
+    // Our standard streams, directory and command line go to our own daemon only.
+    struct stat info;
+    if (lstat(socketPath.c_str(), &info) < 0)
+    {
+        return false;
+    }
+    if (!S_ISSOCK(info.st_mode) || info.st_uid != getuid() || !isPrivateDirectory(socketPath))
+    {
+        fprintf(stderr, "slang:\033[1;35m warning: \033[0mignoring '%s', it is not a socket in a directory of "
+                        "yours only\n", socketPath.c_str());
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0 || !peerIsUs(fd))
+    {
+        close(fd);
+        return false;
+    }
+
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd)))
+    {
+        close(fd);
+        return false;
+    }
+    std::string payload(cwd, strlen(cwd) + 1);
+    for (auto &arg : args)
+    {
+        payload.append(arg.c_str(), arg.size() + 1);
+    }
+    uint32_t length = payload.size();
+
+    struct iovec iov = {&length, sizeof(length)};
+    char control[CMSG_SPACE(StreamCount * sizeof(int))];
+    memset(control, 0, sizeof(control));
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(StreamCount * sizeof(int));
+    int streams[StreamCount] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+    memcpy(CMSG_DATA(cmsg), streams, sizeof(streams));
+
+    int32_t reply;
+    bool ok = sendmsg(fd, &message, 0) == sizeof(length) && writeAll(fd, payload.data(), payload.size()) &&
+              readAll(fd, &reply, sizeof(reply));
+    close(fd);
+    if (ok)
+    {
+        status = reply;
+    }
+    return ok;
+}
+
+/*
+ * serveRequest: in the forked child, take over the client's directory and
+ * streams and run the compiler on its command line.
+ */
+static void serveRequest(int client, int (*compile)(int argc, char **argv))
+{
+    uint32_t length;
+    struct iovec iov = {&length, sizeof(length)};
+    char control[CMSG_SPACE(StreamCount * sizeof(int))];
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    if (recvmsg(client, &message, MSG_WAITALL) != sizeof(length))
+    {
+        _exit(EXIT_FAILURE);
+    }
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    if (!cmsg || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(StreamCount * sizeof(int)))
+    {
+        _exit(EXIT_FAILURE);
+    }
+    int streams[StreamCount];
+    memcpy(streams, CMSG_DATA(cmsg), sizeof(streams));
+
+    std::string payload(length, '\0');
+    if (!readAll(client, &payload[0], length) || payload.empty() || payload.back() != '\0')
+    {
+        _exit(EXIT_FAILURE);
+    }
+    close(client);
+
+    for (int i = 0; i < StreamCount; i++)
+    {
+        dup2(streams[i], i);
+        close(streams[i]);
+    }
+
+    std::vector<char *> argv;
+    for (size_t i = 0; i < payload.size(); i += strlen(&payload[i]) + 1)
+    {
+        argv.push_back(&payload[i]);
+    }
+    if (chdir(argv.front()) < 0)
+    {
+        fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot enter '%s': %s\n", argv.front(), strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    // argv[0] takes the place of the directory.
+    argv.front() = const_cast<char *>("slang");
+    argv.push_back(nullptr);
+
+    // exit() rather than return, stdio and LLVM's streams flush into the client's descriptors.
+    exit(compile(argv.size() - 1, argv.data()));
+}
+
+/*
+ * reapWorkers: send the exit status of every finished child to its client.
+ */
+static void reapWorkers(std::map<pid_t, int> &pending)
+{
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+    {
+        auto it = pending.find(pid);
+        if (it == pending.end())
+        {
+            continue;
+        }
+        int32_t reply = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        writeAll(it->second, &reply, sizeof(reply));
+        close(it->second);
+        pending.erase(it);
+    }
+}
+
+static void onChild(int)
+{
+    // Only here to interrupt ppoll().
+}
+
+int runDaemon(const std::string &socketPath, int (*compile)(int argc, char **argv))
+{
+    struct sockaddr_un address;
+    if (!makeAddress(socketPath, address))
+    {
+        return EXIT_FAILURE;
+    }
+    if (!makePrivateDirectory(socketPath))
+    {
+        return EXIT_FAILURE;
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    unlink(socketPath.c_str());
+    // The socket is created rw------- rather than changed to it after bind().
+    mode_t mask = umask(S_IRWXG | S_IRWXO | S_IXUSR);
+    bool bound = listener >= 0 && bind(listener, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0;
+    umask(mask);
+    if (!bound || listen(listener, SOMAXCONN) < 0)
+    {
+        fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot listen on '%s': %s\n", socketPath.c_str(),
+                strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    // SIGCHLD stays blocked except inside ppoll(), so no exit status is missed between two polls.
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onChild;
+    sigaction(SIGCHLD, &action, nullptr);
+    sigset_t blocked;
+    sigset_t waiting;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &blocked, &waiting);
+    sigdelset(&waiting, SIGCHLD);
+
+    std::map<pid_t, int> pending;
+    for (;;)
+    {
+        reapWorkers(pending);
+
+        struct pollfd poller = {listener, POLLIN, 0};
+        if (ppoll(&poller, 1, nullptr, &waiting) <= 0)
+        {
+            continue;
+        }
+        int client = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0)
+        {
+            continue;
+        }
+        // Compiles run with our rights, for our user only.
+        if (!peerIsUs(client))
+        {
+            close(client);
+            continue;
+        }
+
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(listener);
+            sigprocmask(SIG_SETMASK, &waiting, nullptr);
+            signal(SIGCHLD, SIG_DFL);
+            serveRequest(client, compile);
+        } else if (pid < 0)
+        {
+            int32_t reply = EXIT_FAILURE;
+            writeAll(client, &reply, sizeof(reply));
+            close(client);
+        } else
+        {
+            pending[pid] = client;
+        }
+    }
+}
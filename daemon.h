@@ -0,0 +1,39 @@
+#ifndef SLANG_DAEMON_H
+#define SLANG_DAEMON_H
+
+#include <string>
+#include <vector>
+
+/*
+ * Compile server: a warm slang process listening on a Unix-domain socket.
+ * A request carries the client's working directory, command line and its
+ * stdin/stdout/stderr (passed as SCM_RIGHTS), so output files and diagnostics
+ * land exactly where a direct invocation would put them. The reply is the exit status.
+ */
+
+/*
+ * defaultSocketPath: $SLANG_DAEMON_SOCKET, $XDG_RUNTIME_DIR/slang.sock, or a
+ * socket in the per-user directory /tmp/slang-<uid>.
+ */
+std::string defaultSocketPath();
+
+/*
+ * runDaemon: serve compile requests until killed. Every request is compiled
+ * in a child forked from this process, which inherits its initialized LLVM
+ * and the untouched option globals. The socket is rw------- in a directory
+ * only we can write, created if missing, and requests from other users are refused.
+ * @param socketPath -- where to listen, a stale socket is replaced.
+ * @param compile -- the command line entry point, run in the child.
+ * @return only on error, with an exit status.
+ */
+int runDaemon(const std::string &socketPath, int (*compile)(int argc, char **argv));
+
+/*
+ * sendRequest: client side, send the current directory, args and standard
+ * streams to the daemon and wait for the exit status. They are only sent to
+ * a socket of ours, in a directory only we can write, served by our user.
+ * @return false if no daemon answered, nothing was compiled then.
+ */
+bool sendRequest(const std::string &socketPath, const std::vector<std::string> &args, int &status);
+
+#endif //SLANG_DAEMON_H
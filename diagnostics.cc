@@ -0,0 +1,70 @@
+#include <cstdarg>
+#include <cstdio>
+#include "diagnostics.h"
+
+// State of the innermost DiagnosticScope of each thread.
+static thread_local std::string *diagnosticBuffer = nullptr;
+static thread_local const char *diagnosticFilename = "slang";
+static thread_local int errors = 0;
+
+DiagnosticScope::DiagnosticScope(std::string *buffer, const char *filename) :
+        previousBuffer(diagnosticBuffer),
+        previousFile(diagnosticFilename),
+        previousErrors(errors)
+{
+    diagnosticBuffer = buffer;
+    diagnosticFilename = filename;
+    errors = 0;
+}
+
+DiagnosticScope::~DiagnosticScope()
+{
+    diagnosticBuffer = previousBuffer;
+    diagnosticFilename = previousFile;
+    errors = previousErrors;
+}
+
+void reportDiagnostic(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    if (!diagnosticBuffer)
+    {
+        // Keep the order with what was printed to stdout so far.
+        fflush(stdout);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        return;
+    }
+
+    va_list retry;
+    va_copy(retry, args);
+    char message[512];
+    int length = vsnprintf(message, sizeof(message), format, args);
+    if (length >= 0 && (size_t) length < sizeof(message))
+    {
+        diagnosticBuffer->append(message, length);
+    } else if (length > 0)
+    {
+        std::string large(length + 1, '\0');
+        vsnprintf(&large[0], large.size(), format, retry);
+        diagnosticBuffer->append(large, 0, length);
+    }
+    va_end(retry);
+    va_end(args);
+}
+
+const char *diagnosticFile()
+{
+    return diagnosticFilename;
+}
+
+void countError()
+{
+    errors++;
+}
+
+int errorCount()
+{
+    return errors;
+}
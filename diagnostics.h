@@ -0,0 +1,43 @@
+#ifndef SLANG_DIAGNOSTICS_H
+#define SLANG_DIAGNOSTICS_H
+
+#include <string>
+
+/*
+ * DiagnosticScope: while it lives, messages of the calling thread are
+ * collected in buffer (stderr if nullptr), errors are counted from zero and
+ * source locations refer to filename. Scopes nest, the previous one is
+ * restored on destruction. Every compile runs in a scope of its own, so
+ * compiles on different threads never see each other's diagnostics.
+ */
+class DiagnosticScope
+{
+public:
+    DiagnosticScope(std::string *buffer, const char *filename);
+
+    ~DiagnosticScope();
+
+private:
+    std::string *previousBuffer;
+    const char *previousFile;
+    int previousErrors;
+};
+
+/*
+ * reportDiagnostic: printf-style message to the current scope.
+ */
+void reportDiagnostic(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/*
+ * diagnosticFile: the input that source locations of the current scope refer to.
+ */
+const char *diagnosticFile();
+
+/*
+ * countError: note an error found after parsing, e.g. during IR generation.
+ */
+void countError();
+
+int errorCount();
+
+#endif //SLANG_DIAGNOSTICS_H
@@ -2,80 +2,210 @@
 #include <cassert>
 #include <cctype>
 #include <iostream>
-#include "IR.h"
+#include <iterator>
+#include <llvm/ADT/Twine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
 #include "absyn.h"
-#include "debug.h"
+#include "diagnostics.h"
 #include "driver.h"
-#include "target_gen.h"
+#include "link.h"
+#include "time_report.h"
 
-extern int yyparse();
+using namespace llvm;
 
-extern int yynerrs;
-extern bool emptyFile;
-extern bool DontLink;
-extern std::string OutputFile;
-extern std::shared_ptr<AST_Block> programBlock;
-std::istream *lexer_ins_;
+Driver::Driver(const Options &options) : options(options)
+{
+}
 
 Driver::~Driver() = default;
 
-void Driver::parse(std::string filename)
+bool Driver::parse(std::string filename)
 {
     assert(!filename.empty());
-    this->filename = filename;
+    options.InputName = filename;
+
+    if (StringRef(filename).endswith(".ast"))
+    {
+        return parseAST(filename);
+    }
 
     std::ifstream infile(filename);
     if (!infile.good())
     {
-        fprintf(stderr, "slang:\033[1;31m error:\033[0m no such file or directory: \'%s\'\n", filename.c_str());
-        fprintf(stderr, "slang:\033[1;31m error:\033[0m no input files\n");
-        exit(EXIT_FAILURE);
+        reportDiagnostic("slang:\033[1;31m error:\033[0m no such file or directory: \'%s\'\n", filename.c_str());
+        reportDiagnostic("slang:\033[1;31m error:\033[0m no input files\n");
+        return false;
     }
-    parse_helper(infile);
+    return parse_helper(infile);
 }
 
-void Driver::parse(std::istream &iss)
+bool Driver::parse(std::istream &iss)
 {
     if (!iss.good() && iss.eof())
     {
-        return;
+        return true;
     }
-    parse_helper(iss);
+    return parse_helper(iss);
 }
 
-void Driver::parse_helper(std::istream &stream)
+bool Driver::parse_helper(std::istream &stream)
 {
-    const int accept(0);
+    std::string source((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return finish(compiler.compile(source, options));
+}
 
-    lexer_ins_ = &stream;
+bool Driver::parseAST(const std::string &filename)
+{
+    // Mapped rather than read for large files, the reader decodes in place.
+    auto BufferOrErr = MemoryBuffer::getFile(filename, -1, false);
+    if (!BufferOrErr)
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m cannot open file '%s': %s\n", filename.c_str(),
+                         BufferOrErr.getError().message().c_str());
+        return false;
+    }
+    StringRef data = (*BufferOrErr)->getBuffer();
+    return finish(compiler.compileAST(data.data(), data.size(), options));
+}
 
-    if (yyparse() != accept || yynerrs > 0)
+bool Driver::finish(const CompileResult &result)
+{
+    if (!result.diagnostics.empty())
+    {
+        reportDiagnostic("%s", result.diagnostics.c_str());
+    }
+    std::cout << result.mirDump;
+    if (!result.success)
     {
-        fprintf(stderr, "%d errors generated.\n", yynerrs);
-        exit(EXIT_FAILURE);
+        return false;
     }
+    programBlock = result.ast;
+    return writeOutputs(result);
+}
+
+/*
+ * writeFile: create or truncate filename and write bytes to it.
+ */
+static bool writeFile(const std::string &filename, const std::string &bytes)
+{
+    std::error_code EC;
+    raw_fd_ostream OS(filename, EC, sys::fs::F_None);
+    if (EC)
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m cannot open file '%s': %s\n", filename.c_str(),
+                         EC.message().c_str());
+        return false;
+    }
+    OS << bytes;
+    return true;
+}
 
-    if (!emptyFile)
+/*
+ * createObjectFile: a unique object per compile, so that parallel builds in
+ * one directory don't clobber each other.
+ * @return the object's name, empty if it can't be created.
+ */
+static std::string createObjectFile(const std::string &filename)
+{
+    SmallString<128> object;
+    StringRef stem = filename.empty() ? StringRef("slang") : sys::path::stem(filename);
+    std::error_code EC = sys::fs::createTemporaryFile(stem, "o", object);
+    if (EC)
     {
-#ifdef AST_DEBUG
-        std::cout << programBlock << std::endl;
-        programBlock->print("--");
-#endif
+        reportDiagnostic("slang:\033[1;31m error:\033[0m cannot create temporary file: %s\n", EC.message().c_str());
+        return "";
+    }
+    return object.str().str();
+}
 
-        CodeGenContext context(filename);
-        context.generateCode(*programBlock);
-        if (yynerrs > 0)
+/*
+ * getPartitionName: object file name of a code generation partition,
+ * "output.o" for partition 0 and "output.1.o", "output.2.o"... after it.
+ */
+static std::string getPartitionName(const std::string &filename, unsigned partition)
+{
+    if (partition == 0)
+    {
+        return filename;
+    }
+    StringRef Stem = filename;
+    StringRef Extension = sys::path::extension(filename);
+    Stem = Stem.drop_back(Extension.size());
+    return (Stem + "." + Twine(partition) + (Extension.empty() ? ".o" : Extension)).str();
+}
+
+bool Driver::writeOutputs(const CompileResult &result)
+{
+    if (options.SaveTemps)
+    {
+        writeFile(options.Prefix + ".ll", result.savedIR);
+        writeFile(options.Prefix + ".bc", result.savedBitcode);
+        writeFile(options.Prefix + ".s", result.savedAssembly);
+    }
+    if (options.SaveOptimizationRecord)
+    {
+        std::string record = options.OptimizationRecordFile.empty() ? options.Prefix + ".opt.yaml"
+                                                                    : options.OptimizationRecordFile;
+        if (!writeFile(record, result.optimizationRecord))
+        {
+            return false;
+        }
+    }
+
+    objectFiles.clear();
+    if (result.outputs.empty())
+    {
+        // Nothing to compile in an empty input.
+        return true;
+    }
+
+    if (!options.DontLink)
+    {
+        for (auto &output : result.outputs)
         {
-            fprintf(stderr, "%d errors generated.\n", yynerrs);
-            exit(EXIT_FAILURE);
+            std::string object = createObjectFile(options.InputName);
+            if (object.empty() || !writeFile(object, output))
+            {
+                return false;
+            }
+            objectFiles.push_back(object);
         }
+        return true;
+    }
 
-        if (DontLink)
+    if (result.outputs.size() == 1)
+    {
+        if (!writeFile(options.OutputFile, result.outputs.front()))
         {
-            generateTarget(context, OutputFile);
-        } else
+            return false;
+        }
+        objectFiles = {options.OutputFile};
+        return true;
+    }
+
+    // A single object was asked for: merge the partitions into a relocatable object.
+    std::vector<std::string> parts;
+    for (unsigned i = 0; i < result.outputs.size(); i++)
+    {
+        parts.push_back(getPartitionName(options.OutputFile + ".part", i));
+        if (!writeFile(parts.back(), result.outputs[i]))
         {
-            generateTarget(context);
+            return false;
         }
     }
+    bool merged = linkRelocatable(parts, options.OutputFile, options);
+    for (auto &part : parts)
+    {
+        sys::fs::remove(part);
+    }
+    if (!merged)
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m cannot merge code generation partitions\n");
+        return false;
+    }
+    objectFiles = {options.OutputFile};
+    return true;
 }
@@ -1,32 +1,72 @@
 #ifndef SLANG_DRIVER_H
 #define SLANG_DRIVER_H
 
+#include <memory>
 #include <string>
 #include <istream>
+#include <vector>
+#include "compiler.h"
+#include "options.h"
 
+class AST_Block;
+
+/*
+ * Driver: the command line's side of a compile. It reads the input, runs a
+ * CompilerInstance and writes what it produced to the files that the options
+ * name.
+ */
 class Driver
 {
 public:
-    Driver() = default;
+    explicit Driver(const Options &options);
 
     virtual ~Driver();
 
     /*
-     * parse: parse from a file.
+     * parse: parse from a file, or read the AST from a -emit-ast file ending in ".ast".
      * @param filename -- valid string with input file.
+     * @return false if the file could not be compiled, the diagnostics have been reported.
      */
-    void parse(std::string filename);
+    bool parse(std::string filename);
 
     /*
      * parse: parse from a c++ input stream.
      * @param: iss -- std::istream, valid input stream.
      */
-    void parse(std::istream &iss);
+    bool parse(std::istream &iss);
+
+    /*
+     * getObjectFiles: object files written by the last parse, to be linked.
+     */
+    const std::vector<std::string> &getObjectFiles() const
+    {
+        return objectFiles;
+    }
+
+    /*
+     * getProgramBlock: the AST of the last parse, nullptr for a cache hit.
+     */
+    std::shared_ptr<AST_Block> getProgramBlock() const
+    {
+        return programBlock;
+    }
 
 private:
-    void parse_helper(std::istream &stream);
+    bool parse_helper(std::istream &stream);
+
+    bool parseAST(const std::string &filename);
+
+    /*
+     * finish: report a compile's diagnostics and write its outputs.
+     */
+    bool finish(const CompileResult &result);
+
+    bool writeOutputs(const CompileResult &result);
 
-    std::string filename;
+    Options options;
+    CompilerInstance compiler;
+    std::vector<std::string> objectFiles;
+    std::shared_ptr<AST_Block> programBlock;
 };
 
 #endif //SLANG_DRIVER_H
@@ -0,0 +1,628 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ast_visitor.h"
+#include "fold.h"
+#include "parser.h"
+
+namespace
+{
+
+/*
+ * Constant: the value of a literal-only expression as IR generation would
+ * compute it, an i32, an i1 from a comparison or a double.
+ */
+struct Constant
+{
+    enum Kind
+    {
+        Int32, Bool, Double
+    } kind;
+    uint32_t bits;
+    double real;
+};
+
+int32_t toSigned(uint32_t value)
+{
+    int32_t result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+bool fromLiteral(const AST_Expression *expression, Constant &constant)
+{
+    if (expression->getKind() == ASTKind::Integer)
+    {
+        // ConstantInt::get() truncates to the i32 of an integer literal.
+        constant.kind = Constant::Int32;
+        constant.bits = (uint32_t) static_cast<const AST_Integer *>(expression)->value;
+        return true;
+    } else if (expression->getKind() == ASTKind::Double)
+    {
+        constant.kind = Constant::Double;
+        constant.real = static_cast<const AST_Double *>(expression)->value;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * toBoolean: the CastToBoolean() of IR generation, which truncates integers to
+ * their low bit.
+ */
+bool toBoolean(const Constant &constant)
+{
+    if (constant.kind == Constant::Double)
+    {
+        return constant.real < 0.0 || constant.real > 0.0;
+    }
+    return (constant.bits & 1) != 0;
+}
+
+/*
+ * evaluateBinary: lhs op rhs like AST_BinaryOperator::generateCode(), false
+ * for what it would reject or leave to run time: MOD, bitwise operators on
+ * doubles, mixing i1 and i32, and division and shifts without a defined result.
+ */
+bool evaluateBinary(int op, Constant lhs, Constant rhs, Constant &result)
+{
+    if (lhs.kind == Constant::Double || rhs.kind == Constant::Double)
+    {
+        // Integers are converted with UIToFP.
+        double l = lhs.kind == Constant::Double ? lhs.real : (double) lhs.bits;
+        double r = rhs.kind == Constant::Double ? rhs.real : (double) rhs.bits;
+        result.kind = Constant::Double;
+        switch (op)
+        {
+            case ADD_OP:
+                result.real = l + r;
+                return true;
+            case SUB_OP:
+                result.real = l - r;
+                return true;
+            case MUL_OP:
+                result.real = l * r;
+                return true;
+            case DIV_OP:
+                result.real = l / r;
+                return true;
+            default:
+                break;
+        }
+        result.kind = Constant::Bool;
+        switch (op)
+        {
+            case LT_OP:
+                // FCmpULT: also true if either side is NaN.
+                result.bits = !(l >= r);
+                return true;
+            case LE_OP:
+                result.bits = l <= r;
+                return true;
+            case GE_OP:
+                result.bits = l >= r;
+                return true;
+            case GT_OP:
+                result.bits = l > r;
+                return true;
+            case EQ_OP:
+                result.bits = l == r;
+                return true;
+            case NE_OP:
+                result.bits = l < r || l > r;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    if (lhs.kind != rhs.kind)
+    {
+        return false;
+    }
+    uint32_t l = lhs.bits, r = rhs.bits;
+    if (lhs.kind == Constant::Bool)
+    {
+        // Comparisons only meet in conditions like (a < b) && (c < d).
+        result.kind = Constant::Bool;
+        switch (op)
+        {
+            case AND_OP:
+            case BIT_AND_OP:
+                result.bits = l & r;
+                return true;
+            case OR_OP:
+            case BIT_OR_OP:
+                result.bits = l | r;
+                return true;
+            case BIT_XOR_OP:
+            case NE_OP:
+                result.bits = l ^ r;
+                return true;
+            case EQ_OP:
+                result.bits = !(l ^ r);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    result.kind = Constant::Int32;
+    switch (op)
+    {
+        case ADD_OP:
+            result.bits = l + r;
+            return true;
+        case SUB_OP:
+            result.bits = l - r;
+            return true;
+        case MUL_OP:
+            result.bits = l * r;
+            return true;
+        case DIV_OP:
+            if (r == 0 || (l == 0x80000000u && r == 0xffffffffu))
+            {
+                return false;
+            }
+            result.bits = (uint32_t) (toSigned(l) / toSigned(r));
+            return true;
+        case AND_OP:
+        case BIT_AND_OP:
+            result.bits = l & r;
+            return true;
+        case OR_OP:
+        case BIT_OR_OP:
+            result.bits = l | r;
+            return true;
+        case BIT_XOR_OP:
+            result.bits = l ^ r;
+            return true;
+        case LEFT_OP:
+            if (r >= 32)
+            {
+                return false;
+            }
+            result.bits = l << r;
+            return true;
+        case RIGHT_OP:
+            if (r >= 32)
+            {
+                return false;
+            }
+            // AShr, without relying on >> of a negative int.
+            result.bits = (l & 0x80000000u) ? ~(~l >> r) : l >> r;
+            return true;
+        default:
+            break;
+    }
+    result.kind = Constant::Bool;
+    switch (op)
+    {
+        case LT_OP:
+            // ICmpULT.
+            result.bits = l < r;
+            return true;
+        case LE_OP:
+            result.bits = toSigned(l) <= toSigned(r);
+            return true;
+        case GE_OP:
+            result.bits = toSigned(l) >= toSigned(r);
+            return true;
+        case GT_OP:
+            result.bits = toSigned(l) > toSigned(r);
+            return true;
+        case EQ_OP:
+            result.bits = l == r;
+            return true;
+        case NE_OP:
+            result.bits = l != r;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * evaluate: the value of an already folded expression, only comparisons and
+ * logic on comparisons are left for it to compute.
+ */
+bool evaluate(const AST_Expression *expression, Constant &constant)
+{
+    if (fromLiteral(expression, constant))
+    {
+        return true;
+    }
+    if (expression->getKind() != ASTKind::BinaryOperator)
+    {
+        return false;
+    }
+    auto binary = static_cast<const AST_BinaryOperator *>(expression);
+    Constant lhs, rhs;
+    return evaluate(binary->lhs.get(), lhs) && evaluate(binary->rhs.get(), rhs) &&
+           evaluateBinary(binary->op, lhs, rhs, constant);
+}
+
+bool isIntType(const AST_Identifier &type)
+{
+    return !type.isArray && type.name == "int";
+}
+
+class ASTFolder
+{
+public:
+    FoldStatistics statistics;
+
+    void foldProgram(AST_Block &programBlock)
+    {
+        scopes.emplace_back();
+        foldStatements(*programBlock.statements);
+        scopes.pop_back();
+    }
+
+private:
+    // Names declared in every scope IR generation opens, whether they are an int.
+    std::vector<std::unordered_map<std::string, bool>> scopes;
+    // Functions declared so far, whether they return an int.
+    std::unordered_map<std::string, bool> functions;
+
+    void declare(const AST_VariableDeclaration &declaration)
+    {
+        scopes.back()[declaration.id->name] = isIntType(*declaration.type);
+    }
+
+    /*
+     * isInt: whether expression is known to have the type int.
+     */
+    bool isInt(const AST_Expression *expression) const
+    {
+        switch (expression->getKind())
+        {
+            case ASTKind::Integer:
+                return true;
+            case ASTKind::Identifier:
+            {
+                auto &name = static_cast<const AST_Identifier *>(expression)->name;
+                for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++)
+                {
+                    auto it = scope->find(name);
+                    if (it != scope->end())
+                    {
+                        return it->second;
+                    }
+                }
+                return false;
+            }
+            case ASTKind::MethodCall:
+            {
+                auto it = functions.find(static_cast<const AST_MethodCall *>(expression)->id->name);
+                return it != functions.end() && it->second;
+            }
+            case ASTKind::BinaryOperator:
+            {
+                auto binary = static_cast<const AST_BinaryOperator *>(expression);
+                switch (binary->op)
+                {
+                    case ADD_OP:
+                    case SUB_OP:
+                    case MUL_OP:
+                    case DIV_OP:
+                    case AND_OP:
+                    case BIT_AND_OP:
+                    case OR_OP:
+                    case BIT_OR_OP:
+                    case BIT_XOR_OP:
+                    case LEFT_OP:
+                    case RIGHT_OP:
+                        return isInt(binary->lhs.get()) && isInt(binary->rhs.get());
+                    default:
+                        return false;
+                }
+            }
+            default:
+                return false;
+        }
+    }
+
+    void foldStatements(AST_StatementList &statements)
+    {
+        for (auto &statement : statements)
+        {
+            foldStatement(*statement);
+        }
+    }
+
+    /*
+     * foldScope: a block that IR generation runs in a scope of its own.
+     */
+    void foldScope(AST_Block &block)
+    {
+        scopes.emplace_back();
+        foldStatements(*block.statements);
+        scopes.pop_back();
+    }
+
+    void foldStatement(AST_Statement &statement)
+    {
+        switch (statement.getKind())
+        {
+            case ASTKind::ExpressionStatement:
+                foldExpression(static_cast<AST_ExpressionStatement &>(statement).expression);
+                break;
+            case ASTKind::VariableDeclaration:
+            {
+                auto &declaration = static_cast<AST_VariableDeclaration &>(statement);
+                foldExpression(declaration.assignmentExpr);
+                declare(declaration);
+                break;
+            }
+            case ASTKind::ArrayInitialization:
+            {
+                auto &initialization = static_cast<AST_ArrayInitialization &>(statement);
+                foldExpressions(initialization.expressionList);
+                declare(*initialization.declaration);
+                break;
+            }
+            case ASTKind::FunctionDeclaration:
+            {
+                auto &function = static_cast<AST_FunctionDeclaration &>(statement);
+                functions[function.id->name] = isIntType(*function.type);
+                if (function.isExternal || !function.block)
+                {
+                    break;
+                }
+                // Parameters and the body share the scope of the function.
+                scopes.emplace_back();
+                for (auto &argument : *function.arguments)
+                {
+                    declare(*argument);
+                }
+                foldStatements(*function.block->statements);
+                scopes.pop_back();
+                break;
+            }
+            case ASTKind::ReturnStatement:
+                foldExpression(static_cast<AST_ReturnStatement &>(statement).expression);
+                break;
+            case ASTKind::IfStatement:
+                foldIf(static_cast<AST_IfStatement &>(statement));
+                break;
+            case ASTKind::ForStatement:
+            {
+                auto &forStatement = static_cast<AST_ForStatement &>(statement);
+                foldExpression(forStatement.initial);
+                foldExpression(forStatement.condition);
+                foldExpression(forStatement.increment);
+                foldScope(*forStatement.block);
+                break;
+            }
+            default:
+                // Struct declarations have nothing to fold.
+                break;
+        }
+    }
+
+    /*
+     * foldIf: reduce a constant condition to the literal 0 or 1. Both branches
+     * stay, the program is checked with the dead one, and IR generation drops
+     * it once the program compiled without errors.
+     */
+    void foldIf(AST_IfStatement &statement)
+    {
+        foldExpression(statement.condition);
+        foldScope(*statement.trueBlock);
+        if (statement.falseBlock)
+        {
+            foldScope(*statement.falseBlock);
+        }
+        Constant condition;
+        if (!evaluate(statement.condition.get(), condition))
+        {
+            return;
+        }
+        statistics.deadBranches++;
+        Constant literal;
+        if (fromLiteral(statement.condition.get(), literal) && literal.kind == Constant::Int32)
+        {
+            // Already as simple as it gets.
+            return;
+        }
+        auto value = std::make_shared<AST_Integer>(toBoolean(condition) ? 1 : 0);
+        value->row = statement.condition->row;
+        value->col = statement.condition->col;
+        statement.condition = value;
+    }
+
+    void foldExpressions(const std::shared_ptr<AST_ExpressionList> &expressions)
+    {
+        if (expressions)
+        {
+            for (auto &expression : *expressions)
+            {
+                foldExpression(expression);
+            }
+        }
+    }
+
+    void foldArrayIndex(AST_ArrayIndex *index)
+    {
+        if (index)
+        {
+            foldExpressions(index->expressions);
+        }
+    }
+
+    void foldExpression(std::shared_ptr<AST_Expression> &expression)
+    {
+        if (!expression)
+        {
+            return;
+        }
+        switch (expression->getKind())
+        {
+            case ASTKind::BinaryOperator:
+            {
+                auto binary = std::static_pointer_cast<AST_BinaryOperator>(expression);
+                foldExpression(binary->lhs);
+                foldExpression(binary->rhs);
+                auto simplified = foldBinary(*binary);
+                if (simplified)
+                {
+                    expression = simplified;
+                }
+                break;
+            }
+            case ASTKind::MethodCall:
+                foldExpressions(static_cast<AST_MethodCall &>(*expression).arguments);
+                break;
+            case ASTKind::Assignment:
+                foldExpression(static_cast<AST_Assignment &>(*expression).rhs);
+                break;
+            case ASTKind::Block:
+                // Unlike the blocks of statements, it has no scope of its own.
+                foldStatements(*static_cast<AST_Block &>(*expression).statements);
+                break;
+            case ASTKind::ArrayIndex:
+                foldArrayIndex(static_cast<AST_ArrayIndex *>(expression.get()));
+                break;
+            case ASTKind::ArrayAssignment:
+            {
+                auto &assignment = static_cast<AST_ArrayAssignment &>(*expression);
+                foldArrayIndex(assignment.arrayIndex.get());
+                foldExpression(assignment.expression);
+                break;
+            }
+            case ASTKind::StructMember:
+                foldArrayIndex(static_cast<AST_StructMember &>(*expression).array.get());
+                break;
+            case ASTKind::StructAssignment:
+            {
+                auto &assignment = static_cast<AST_StructAssignment &>(*expression);
+                foldArrayIndex(assignment.structMember->array.get());
+                foldExpression(assignment.expression);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    /*
+     * foldBinary: what binary simplifies to, nullptr to keep it.
+     */
+    std::shared_ptr<AST_Expression> foldBinary(AST_BinaryOperator &binary)
+    {
+        Constant lhs, rhs, result;
+        bool lhsLiteral = fromLiteral(binary.lhs.get(), lhs);
+        bool rhsLiteral = fromLiteral(binary.rhs.get(), rhs);
+        if (lhsLiteral && rhsLiteral)
+        {
+            // A comparison yields an i1, which no literal has: it stays.
+            if (!evaluateBinary(binary.op, lhs, rhs, result) || result.kind == Constant::Bool)
+            {
+                return nullptr;
+            }
+            std::shared_ptr<AST_Expression> literal;
+            if (result.kind == Constant::Int32)
+            {
+                literal = std::make_shared<AST_Integer>(result.bits);
+            } else
+            {
+                literal = std::make_shared<AST_Double>(result.real);
+            }
+            literal->row = binary.row;
+            literal->col = binary.col;
+            statistics.folded++;
+            return literal;
+        }
+
+        // Identities, for int operands only: x + 0.0 is not x for x = -0.0,
+        // and x << k is not defined for a double.
+        bool lhsInt = lhsLiteral && lhs.kind == Constant::Int32;
+        bool rhsInt = rhsLiteral && rhs.kind == Constant::Int32;
+        if (!(lhsInt && isInt(binary.rhs.get())) && !(rhsInt && isInt(binary.lhs.get())))
+        {
+            return nullptr;
+        }
+        auto &other = lhsInt ? binary.rhs : binary.lhs;
+        uint32_t value = lhsInt ? lhs.bits : rhs.bits;
+        switch (binary.op)
+        {
+            case ADD_OP:
+                if (value == 0)
+                {
+                    statistics.identities++;
+                    return other;
+                }
+                break;
+            case SUB_OP:
+            case DIV_OP:
+                // 0 - x and 1 / x are no identities.
+                if (rhsInt && value == (binary.op == SUB_OP ? 0u : 1u))
+                {
+                    statistics.identities++;
+                    return other;
+                }
+                break;
+            case MUL_OP:
+                if (value == 1)
+                {
+                    statistics.identities++;
+                    return other;
+                }
+                if (value != 0 && (value & (value - 1)) == 0)
+                {
+                    unsigned shift = 0;
+                    while ((value >> shift) != 1)
+                    {
+                        shift++;
+                    }
+                    auto amount = std::make_shared<AST_Integer>(shift);
+                    amount->row = lhsInt ? binary.lhs->row : binary.rhs->row;
+                    amount->col = lhsInt ? binary.lhs->col : binary.rhs->col;
+                    binary.lhs = other;
+                    binary.rhs = amount;
+                    binary.op = LEFT_OP;
+                    statistics.identities++;
+                }
+                break;
+            default:
+                break;
+        }
+        return nullptr;
+    }
+};
+
+/*
+ * NodeCounter: counts the nodes a walk enters.
+ */
+class NodeCounter : public ASTVisitor<NodeCounter>
+{
+public:
+    size_t count = 0;
+
+    void enter(const AST_Node &)
+    {
+        count++;
+    }
+};
+
+}
+
+FoldStatistics foldAST(AST_Block &programBlock)
+{
+    ASTFolder folder;
+    folder.foldProgram(programBlock);
+    return folder.statistics;
+}
+
+size_t countASTNodes(const AST_Node *node)
+{
+    NodeCounter counter;
+    if (node)
+    {
+        counter.walk(*node);
+    }
+    return counter.count;
+}
@@ -0,0 +1,37 @@
+#ifndef SLANG_FOLD_H
+#define SLANG_FOLD_H
+
+#include <cstddef>
+#include "absyn.h"
+
+/*
+ * FoldStatistics: what foldAST() changed, by kind of rewrite.
+ */
+struct FoldStatistics
+{
+    // Operators on literals replaced by their value.
+    unsigned folded = 0;
+    // x + 0, x - 0, x * 1, x / 1 replaced by x, and x * 2^k by x << k.
+    unsigned identities = 0;
+    // If statements on a constant condition, whose dead branch is dropped after IR generation.
+    unsigned deadBranches = 0;
+};
+
+/*
+ * foldAST: simplify the AST before IR generation, so that the constant
+ * expressions the grammar produces (-x is 0 - x, x += e is x = x + e, ...)
+ * never reach the backend. Rewrites keep the IR generation's semantics:
+ * integer literals are i32, mixed operands convert the integer unsigned,
+ * conditions test the low bit of an integer. Identities are only applied to
+ * operands known to be int, nothing that would change the type of an
+ * expression is folded. Nothing is removed that the semantic checks and IR
+ * generation have not seen, a program compiles with or without folding alike.
+ */
+FoldStatistics foldAST(AST_Block &programBlock);
+
+/*
+ * countASTNodes: the number of nodes in the tree under node, 0 for nullptr.
+ */
+size_t countASTNodes(const AST_Node *node);
+
+#endif //SLANG_FOLD_H
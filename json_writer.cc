@@ -0,0 +1,161 @@
+#include <cstdio>
+#include <cstring>
+#include "json_writer.h"
+
+static const size_t BufferSize = 64 * 1024;
+
+JsonWriter::JsonWriter(std::ostream &os) : os(os)
+{
+    buffer.reserve(BufferSize);
+}
+
+JsonWriter::~JsonWriter()
+{
+    flush();
+}
+
+void JsonWriter::beginNode(const char *typeName)
+{
+    if (!nodes.empty())
+    {
+        OpenNode &parent = nodes.back();
+        if (parent.nameOpen)
+        {
+            write("\",\"children\":[", 14);
+            parent.nameOpen = false;
+        } else
+        {
+            write(',');
+        }
+        parent.hasChildren = true;
+    }
+    write("{\"name\":\"", 9);
+    writeEscaped(typeName, strlen(typeName));
+    nodes.push_back({true, false});
+}
+
+void JsonWriter::appendName(const char *text)
+{
+    writeEscaped(text, strlen(text));
+}
+
+void JsonWriter::appendName(const std::string &text)
+{
+    writeEscaped(text.data(), text.size());
+}
+
+void JsonWriter::appendName(uint64_t value)
+{
+    char digits[20];
+    size_t length = 0;
+    do
+    {
+        digits[length++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (length > 0)
+    {
+        write(digits[--length]);
+    }
+}
+
+void JsonWriter::appendName(int value)
+{
+    if (value < 0)
+    {
+        write('-');
+        appendName((uint64_t) -(int64_t) value);
+    } else
+    {
+        appendName((uint64_t) value);
+    }
+}
+
+void JsonWriter::appendName(double value)
+{
+    char text[512];
+    int length = snprintf(text, sizeof(text), "%f", value);
+    write(text, (size_t) length);
+}
+
+void JsonWriter::endNode()
+{
+    if (nodes.back().hasChildren)
+    {
+        write("]}", 2);
+    } else
+    {
+        write("\"}", 2);
+    }
+    nodes.pop_back();
+    if (nodes.empty())
+    {
+        write('\n');
+    }
+}
+
+void JsonWriter::writeRaw(const char *text)
+{
+    write(text, strlen(text));
+}
+
+void JsonWriter::writeString(const std::string &text)
+{
+    write('"');
+    writeEscaped(text.data(), text.size());
+    write('"');
+}
+
+bool JsonWriter::flush()
+{
+    os.write(buffer.data(), buffer.size());
+    flushedBytes += buffer.size();
+    buffer.clear();
+    os.flush();
+    return (bool) os;
+}
+
+void JsonWriter::write(char c)
+{
+    if (buffer.size() == BufferSize)
+    {
+        flush();
+    }
+    buffer.push_back(c);
+}
+
+void JsonWriter::write(const char *text, size_t length)
+{
+    if (buffer.size() + length > BufferSize)
+    {
+        flush();
+    }
+    buffer.append(text, length);
+}
+
+void JsonWriter::writeEscaped(const char *text, size_t length)
+{
+    static const char Hex[] = "0123456789abcdef";
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char) text[i];
+        if (c == '"' || c == '\\')
+        {
+            write('\\');
+            write((char) c);
+        } else if (c == '\n')
+        {
+            write("\\n", 2);
+        } else if (c == '\t')
+        {
+            write("\\t", 2);
+        } else if (c < 0x20)
+        {
+            char escape[] = {'\\', 'u', '0', '0', Hex[c >> 4], Hex[c & 15]};
+            write(escape, sizeof(escape));
+        } else
+        {
+            write((char) c);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef SLANG_JSON_WRITER_H
+#define SLANG_JSON_WRITER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * JsonWriter: streams the AST as the nested {"name", "children"} objects
+ * read by visualization/AST.html. Nodes are written as the traversal
+ * reaches them, nothing is kept but the open nodes and an output buffer.
+ *
+ *     writer.beginNode("AST_Integer");
+ *     writer.appendName(":");
+ *     writer.appendName(value);
+ *     ... children ...
+ *     writer.endNode();
+ *
+ * The name of a node is only open until its first child begins.
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(std::ostream &os);
+
+    ~JsonWriter();
+
+    void beginNode(const char *typeName);
+
+    void appendName(const char *text);
+
+    void appendName(const std::string &text);
+
+    void appendName(uint64_t value);
+
+    void appendName(int value);
+
+    /*
+     * appendName: value in the format of std::to_string(double).
+     */
+    void appendName(double value);
+
+    void endNode();
+
+    /*
+     * writeRaw: text outside of nodes, e.g. a wrapper around them.
+     */
+    void writeRaw(const char *text);
+
+    /*
+     * writeString: text as a quoted JSON string, outside of nodes.
+     */
+    void writeString(const std::string &text);
+
+    /*
+     * bytesWritten: the output so far, including what is still buffered.
+     */
+    uint64_t bytesWritten() const
+    {
+        return flushedBytes + buffer.size();
+    }
+
+    /*
+     * flush: hand the buffered output to the stream.
+     * @return false if the stream failed.
+     */
+    bool flush();
+
+private:
+    struct OpenNode
+    {
+        bool nameOpen;
+        bool hasChildren;
+    };
+
+    void write(char c);
+
+    void write(const char *text, size_t length);
+
+    void writeEscaped(const char *text, size_t length);
+
+    std::ostream &os;
+    std::string buffer;
+    uint64_t flushedBytes = 0;
+    std::vector<OpenNode> nodes;
+};
+
+#endif //SLANG_JSON_WRITER_H
@@ -0,0 +1,163 @@
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <llvm/ADT/Triple.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#ifdef SLANG_USE_LLD
+#include <lld/Common/Driver.h>
+#endif
+#include "link.h"
+
+extern char **environ;
+
+using namespace llvm;
+
+/*
+ * runClang: run the clang driver on args and wait for it. No shell is in
+ * between, file names reach it as they are.
+ * @return whether clang ran and succeeded.
+ */
+static bool runClang(const std::vector<std::string> &args)
+{
+    std::vector<char *> argv = {const_cast<char *>("clang")};
+    for (auto &arg : args)
+    {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid;
+    int error = posix_spawnp(&pid, "clang", nullptr, nullptr, argv.data(), environ);
+    if (error)
+    {
+        fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot run clang: %s\n", strerror(error));
+        return false;
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/*
+ * linkWithClang: hand the objects to the clang driver, which finds the
+ * runtime libraries itself.
+ */
+static bool linkWithClang(const std::vector<std::string> &objects, const std::string &output,
+                          const Options &options)
+{
+    std::vector<std::string> args = objects;
+    if (options.ProfileGenerate)
+    {
+        // Pulls in the profile runtime that writes the raw profile at exit.
+        args.push_back("-fprofile-generate");
+    }
+    args.push_back("-o");
+    args.push_back(output);
+    return runClang(args);
+}
+
+#ifdef SLANG_USE_LLD
+// lld keeps its state in globals, inputs finishing in parallel link one at a time.
+static std::mutex lldMutex;
+#endif
+
+#ifdef SLANG_USE_LLD
+/*
+ * linkWithLLD: run lld's ELF driver in this process, with the command line
+ * the gcc driver would give the system linker for a dynamically linked C program.
+ */
+static bool linkWithLLD(const std::vector<std::string> &objects, const std::string &output, const Options &options)
+{
+    std::vector<std::string> crt = {options.CRTDir + "/crt1.o", options.CRTDir + "/crti.o",
+                                    options.GCCRuntimeDir + "/crtbegin.o"};
+    for (auto &file : crt)
+    {
+        if (!sys::fs::exists(file))
+        {
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot find '%s', set -crt-dir or -gcc-runtime-dir\n",
+                    file.c_str());
+            return false;
+        }
+    }
+
+    // lld keeps pointers to its arguments, the strings live until the link is done.
+    std::vector<std::string> storage;
+    storage.push_back("-L" + options.CRTDir);
+    storage.push_back("-L" + options.GCCRuntimeDir);
+    for (auto &dir : options.LibraryDirs)
+    {
+        storage.push_back("-L" + dir);
+    }
+
+    std::vector<const char *> args = {"ld.lld", "--eh-frame-hdr", "-dynamic-linker", options.DynamicLinker.c_str(),
+                                      "-o", output.c_str()};
+    for (auto &file : crt)
+    {
+        args.push_back(file.c_str());
+    }
+    for (auto &object : objects)
+    {
+        args.push_back(object.c_str());
+    }
+    for (auto &option : storage)
+    {
+        args.push_back(option.c_str());
+    }
+    std::string crtend = options.GCCRuntimeDir + "/crtend.o";
+    std::string crtn = options.CRTDir + "/crtn.o";
+    for (const char *arg : {"-lgcc", "--as-needed", "-lgcc_s", "--no-as-needed", "-lc", "-lgcc", "--as-needed",
+                            "-lgcc_s", "--no-as-needed", crtend.c_str(), crtn.c_str()})
+    {
+        args.push_back(arg);
+    }
+
+    std::lock_guard<std::mutex> lock(lldMutex);
+    return lld::elf::link(args, false, errs());
+}
+#endif
+
+bool linkExecutable(const std::vector<std::string> &objects, const std::string &output, const Options &options)
+{
+#ifdef SLANG_USE_LLD
+    // lld links for the host only, and the profile runtime is found by the clang driver.
+    if (options.UseLinker == "lld" && options.TargetTripleName.empty() && !options.ProfileGenerate &&
+        Triple(sys::getProcessTriple()).isOSBinFormatELF())
+    {
+        return linkWithLLD(objects, output, options);
+    }
+#endif
+    return linkWithClang(objects, output, options);
+}
+
+bool linkRelocatable(const std::vector<std::string> &objects, const std::string &output, const Options &options)
+{
+    std::string triple = options.TargetTripleName.empty() ? sys::getProcessTriple() : options.TargetTripleName;
+#ifdef SLANG_USE_LLD
+    if (options.UseLinker == "lld" && Triple(triple).isOSBinFormatELF())
+    {
+        std::vector<const char *> args = {"ld.lld", "-r", "-o", output.c_str()};
+        for (auto &object : objects)
+        {
+            args.push_back(object.c_str());
+        }
+        std::lock_guard<std::mutex> lock(lldMutex);
+        return lld::elf::link(args, false, errs());
+    }
+#endif
+    std::vector<std::string> args = {"-target", triple, "-r"};
+    args.insert(args.end(), objects.begin(), objects.end());
+    args.push_back("-o");
+    args.push_back(output);
+    return runClang(args);
+}
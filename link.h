@@ -0,0 +1,27 @@
+#ifndef SLANG_LINK_H
+#define SLANG_LINK_H
+
+#include <string>
+#include <vector>
+#include "options.h"
+
+/*
+ * linkExecutable: link objects into an executable. ELF hosts link in-process
+ * through lld when Slang was built with it, against the CRT and libc found by
+ * -crt-dir, -gcc-runtime-dir and -L. Otherwise the clang driver is spawned.
+ * @param objects -- native object files.
+ * @param output -- the executable to write.
+ * @return whether the link succeeded.
+ */
+bool linkExecutable(const std::vector<std::string> &objects, const std::string &output, const Options &options);
+
+/*
+ * linkRelocatable: merge objects into one relocatable object, in-process with
+ * lld for ELF targets when Slang was built with it, otherwise with 'clang -r'.
+ * @param objects -- native object files.
+ * @param output -- the object to write.
+ * @return whether the link succeeded.
+ */
+bool linkRelocatable(const std::vector<std::string> &objects, const std::string &output, const Options &options);
+
+#endif //SLANG_LINK_H
@@ -0,0 +1,137 @@
+#include <set>
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/LTO/LTO.h>
+#include <llvm/LTO/LTOBackend.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
+#include "lto.h"
+#include "optimize.h"
+#include "target_gen.h"
+#include "debug.h"
+
+using namespace llvm;
+
+std::vector<std::string> thinLink(const std::vector<std::string> &inputs, const std::string &prefix, unsigned jobs,
+                                  const Options &options)
+{
+    initializeTargetRegistry(options);
+
+    std::vector<std::string> natives;
+    // The symbol tables refer into the buffers, keep them alive until the link is done.
+    std::vector<std::unique_ptr<MemoryBuffer>> buffers;
+    std::vector<std::unique_ptr<lto::InputFile>> bitcodeFiles;
+    for (auto &input : inputs)
+    {
+        auto BufferOrErr = MemoryBuffer::getFile(input);
+        if (!BufferOrErr)
+        {
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m no such file or directory: \'%s\'\n", input.c_str());
+            exit(EXIT_FAILURE);
+        }
+        if (identify_magic((*BufferOrErr)->getBuffer()) != file_magic::bitcode)
+        {
+            natives.push_back(input);
+            continue;
+        }
+        auto FileOrErr = lto::InputFile::create((*BufferOrErr)->getMemBufferRef());
+        if (!FileOrErr)
+        {
+            errs() << "slang: " << input << ": " << toString(FileOrErr.takeError()) << "\n";
+            exit(EXIT_FAILURE);
+        }
+        buffers.push_back(std::move(*BufferOrErr));
+        bitcodeFiles.push_back(std::move(*FileOrErr));
+    }
+
+    lto::Config Conf;
+    Conf.DefaultTriple = getTargetTriple(options);
+    Conf.CPU = getCPUStr(options);
+    SmallVector<StringRef, 16> Attrs;
+    auto Features = getFeaturesStr(options);
+    StringRef(Features).split(Attrs, ",", -1, false);
+    for (auto &Attr : Attrs)
+    {
+        Conf.MAttrs.push_back(Attr.str());
+    }
+    Conf.OptLevel = (unsigned) parseOptimizationLevel(options.OptimizationLevel);
+    Conf.CGOptLevel = getCodeGenOptLevel(options);
+
+    lto::LTO Lto(std::move(Conf), lto::createInProcessThinBackend(jobs ? jobs : heavyweight_hardware_concurrency()));
+
+    /*
+     * Resolve symbols the way a linker would: the first definition prevails.
+     * Native objects may reference anything, otherwise only main has to stay
+     * visible and the rest can be internalized after importing.
+     */
+    std::set<std::string> defined;
+    for (auto &File : bitcodeFiles)
+    {
+        std::vector<lto::SymbolResolution> Resolutions;
+        for (auto &Sym : File->symbols())
+        {
+            lto::SymbolResolution Res;
+            if (!Sym.isUndefined() && defined.insert(Sym.getName().str()).second)
+            {
+                Res.Prevailing = true;
+                Res.FinalDefinitionInLinkageUnit = true;
+            }
+            Res.VisibleToRegularObj = !natives.empty() || Sym.getName() == "main";
+            Resolutions.push_back(Res);
+        }
+        if (Error E = Lto.add(std::move(File), Resolutions))
+        {
+            errs() << "slang: " << toString(std::move(E)) << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /*
+     * Temporary files rather than names next to the output, so that links of
+     * the same output in parallel don't clobber each other. Called from the
+     * backend threads, each task only touches its own entry.
+     */
+    std::vector<std::string> objects(Lto.getMaxTasks());
+    StringRef stem = prefix.empty() ? StringRef("slang") : sys::path::stem(prefix);
+    auto AddStream = [&](size_t Task) -> std::unique_ptr<lto::NativeObjectStream> {
+        int FD;
+        SmallString<128> object;
+        std::error_code EC = sys::fs::createTemporaryFile(stem + ".lto." + Twine(Task), "o", FD, object);
+        if (EC)
+        {
+            report_fatal_error("cannot create temporary file: " + EC.message());
+        }
+        objects[Task] = object.str().str();
+        auto OS = llvm::make_unique<raw_fd_ostream>(FD, true);
+        return llvm::make_unique<lto::NativeObjectStream>(std::move(OS));
+    };
+    if (Error E = Lto.run(AddStream))
+    {
+        errs() << "slang: " << toString(std::move(E)) << "\n";
+        for (auto &object : objects)
+        {
+            if (!object.empty())
+            {
+                sys::fs::remove(object);
+            }
+        }
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<std::string> results;
+    for (auto &object : objects)
+    {
+        // Tasks that had nothing to generate never ask for a stream.
+        if (!object.empty())
+        {
+            results.push_back(object);
+        }
+    }
+#ifdef OBJ_DEBUG
+    outs() << "ThinLTO wrote " << results.size() << " objects for " << inputs.size() << " inputs\n";
+#endif
+    results.insert(results.end(), natives.begin(), natives.end());
+    return results;
+}
@@ -0,0 +1,21 @@
+#ifndef SLANG_LTO_H
+#define SLANG_LTO_H
+
+#include <string>
+#include <vector>
+#include "options.h"
+
+/*
+ * thinLink: run the ThinLTO link step over objects written with -flto=thin.
+ * Functions are imported across modules by the combined summary, then each
+ * module is optimized and code generated on a thread pool.
+ * @param inputs -- bitcode objects, native objects are passed through.
+ * @param prefix -- the output, whose stem names the temporary native objects.
+ * @param jobs -- backend threads, 0 for one per core.
+ * @return the native objects to hand to the system linker. The temporary
+ *         ones are the caller's to remove after linking.
+ */
+std::vector<std::string> thinLink(const std::vector<std::string> &inputs, const std::string &prefix, unsigned jobs,
+                                  const Options &options);
+
+#endif //SLANG_LTO_H
@@ -1,37 +1,225 @@
+#include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <sys/stat.h>
 #include "absyn.h"
+#include "ast_export.h"
+#include "cache.h"
+#include "daemon.h"
+#include "diagnostics.h"
 #include "driver.h"
+#include "link.h"
+#include "lto.h"
+#include "options.h"
+#include "scheduler.h"
+#include "target_gen.h"
+#include "time_report.h"
 
-const char *yyfile;
-extern bool emptyFile;
-extern std::shared_ptr<AST_Block> programBlock;
-
-bool DontLink = false;
-bool EmitIR = false;
-bool EmitASM = false;
-bool EmitBC = false;
-std::string OptimizationLevel = "-O0";
-std::string OutputFile;
-std::string Prefix;
+/*
+ * isLinkInput: whether a command line argument names an object or bitcode
+ * file, as opposed to a source file to compile.
+ */
+static bool isLinkInput(const char *arg)
+{
+    size_t length = strlen(arg);
+    return (length > 2 && strcmp(arg + length - 2, ".o") == 0) ||
+           (length > 3 && strcmp(arg + length - 3, ".bc") == 0);
+}
 
 void showHelpInfo()
 {
     std::cout << "OVERVIEW: Small C language LLVM compiler\n" << std::endl;
     std::cout << "USAGE: slang [options] <inputs>\n" << std::endl;
     std::cout << "OPTIONS:" << std::endl;
-    std::cout << "  " << std::setw(16) << std::left << "-c" << "Only run preprocess, compile, and assemble steps"
+    std::cout << "  " << std::setw(36) << std::left << "-c" << "Only run preprocess, compile, and assemble steps"
               << std::endl;
-    std::cout << "  " << std::setw(16) << std::left << "-emit-llvm"
+    std::cout << "  " << std::setw(36) << std::left << "-emit-llvm"
               << "Use the LLVM representation for assembler and object files" << std::endl;
-    std::cout << "  " << std::setw(16) << std::left << "-o <file>" << "Write output to <file>" << std::endl;
-    std::cout << "  " << std::setw(16) << std::left << "-S" << "Only run preprocess and compilation steps" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-emit-ast"
+              << "Write the parsed AST to <prefix>.ast, which can be compiled instead of the source" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-o <file>" << "Write output to <file>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-S" << "Only run preprocess and compilation steps" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-save-temps"
+              << "Also write <prefix>.ll, <prefix>.bc and <prefix>.s of the optimized module" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-j <threads>"
+              << "Compile several inputs, or optimize the functions of one input, on <threads> threads" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fcodegen-partitions=<n>"
+              << "Split code generation into <n> partitions emitted in parallel" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fprofile-generate[=<dir>]"
+              << "Instrument for profiling, raw profiles are written to <dir> at exit" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fprofile-use=<file>"
+              << "Optimize with a profile merged by 'llvm-profdata merge'" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-flto=thin"
+              << "Emit ThinLTO bitcode, or run the ThinLTO link step on object inputs" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fno-ast-fold"
+              << "Don't fold constants and dead branches in the AST before IR generation" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-ast-fold-stats"
+              << "Report the AST nodes eliminated by folding" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fmir"
+              << "Generate IR through the mid-level IR, inlining tiny functions at -O1 and up" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fbounds-check"
+              << "Trap on array subscripts out of bounds, implies -fmir" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-mir-stats"
+              << "Report the size of the mid-level IR and what its passes did" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-dump-mir"
+              << "Print the mid-level IR after its passes" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-ftime-report"
+              << "Print time and peak memory per phase, function and pass, and LLVM statistics" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-ftime-trace=<file>"
+              << "Write a Chrome trace-event JSON of the compile to <file>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-dump-ast-json=<file>"
+              << "Write the AST to <file> as one JSON tree" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-dump-ast-dir=<dir>"
+              << "Write the AST to <dir> in chunks for visualization/AST.html" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-Rpass=<regex>"
+              << "Report optimizations made by passes whose name matches <regex>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-Rpass-missed=<regex>"
+              << "Report missed optimizations by passes whose name matches <regex>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-Rpass-analysis=<regex>"
+              << "Report why passes whose name matches <regex> did not optimize" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fsave-optimization-record"
+              << "Write all optimization remarks to <prefix>.opt.yaml" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-foptimization-record-file=<file>"
+              << "Write the optimization record to <file>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-daemon[=<socket>]"
+              << "Serve compiles from slang-client on a Unix socket, $SLANG_DAEMON_SOCKET by default" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fcache-dir=<dir>"
+              << "Reuse outputs of identical earlier compiles cached in <dir>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fcache-max-size=<MiB>"
+              << "Evict least recently used cache entries beyond <MiB>, default 1024" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-cache-stats"
+              << "Print cache hits, misses and bytes saved" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-fuse-ld=<lld|clang>"
+              << "Link in-process with lld (default), or through the clang driver" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-crt-dir=<dir>"
+              << "Directory of crt1.o, crti.o, crtn.o and libc" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-gcc-runtime-dir=<dir>"
+              << "Directory of crtbegin.o, crtend.o and libgcc" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-dynamic-linker=<path>"
+              << "Program interpreter of the executable" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-L<dir>" << "Add <dir> to the library search path"
+              << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-march=<cpu>"
+              << "Generate code for <cpu>, 'native' selects the host CPU and its features" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-mcpu=<cpu>" << "Same as -march=<cpu>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-mattr=<attrs>"
+              << "Enable (+attr) or disable (-attr) target features, comma separated" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-mtune=<cpu>" << "Tune scheduling for <cpu>" << std::endl;
+    std::cout << "  " << std::setw(36) << std::left << "-target <triple>" << "Generate code for the given target"
+              << std::endl;
 }
 
-int main(int argc, char **argv)
+/*
+ * defaultOutputFile: the -c output of an input without -o, by output kind.
+ */
+static std::string defaultOutputFile(const Options &options, const std::string &input)
+{
+    std::string prefix = input.substr(0, input.find("."));
+    if (options.EmitAST)
+    {
+        return prefix + ".ast";
+    } else if (options.EmitASM)
+    {
+        return prefix + ".s";
+    } else if (options.EmitBC)
+    {
+        return prefix + ".bc";
+    } else if (options.EmitIR)
+    {
+        return prefix + ".ll";
+    }
+    return prefix + ".o";
+}
+
+/*
+ * compileInput: compile one input on the calling thread.
+ * @param output -- the -c output, unused when linking.
+ * @param files -- receives the files written.
+ * @param ast -- receives the AST, nullptr for a cache hit.
+ * @return false on errors, they have been reported.
+ */
+static bool compileInput(const Options &options, const std::string &input, const std::string &output,
+                         std::vector<std::string> &files, std::shared_ptr<AST_Block> &ast)
+{
+    Options inputOptions = options;
+    inputOptions.Prefix = input.substr(0, input.find("."));
+    inputOptions.OutputFile = output;
+    Driver driver(inputOptions);
+    if (!driver.parse(input))
+    {
+        return false;
+    }
+    files = driver.getObjectFiles();
+    ast = driver.getProgramBlock();
+    return true;
+}
+
+/*
+ * compileInputs: compile several inputs on a work-stealing pool, largest
+ * input first. Each input's diagnostics are printed in command line order.
+ * @param files -- receives the files written, in input order.
+ * @return false if any input had errors.
+ */
+static bool compileInputs(const Options &options, const std::vector<std::string> &inputs, unsigned jobs,
+                          std::vector<std::string> &files)
+{
+    size_t count = inputs.size();
+    std::vector<std::string> diagnostics(count);
+    std::vector<std::vector<std::string>> outputs(count);
+    std::vector<char> succeeded(count, false);
+    std::vector<char> done(count, false);
+    std::mutex printMutex;
+    size_t printed = 0;
+
+    std::vector<std::function<void()>> tasks;
+    std::vector<uint64_t> costs;
+    for (size_t i = 0; i < count; i++)
+    {
+        struct stat status;
+        costs.push_back(stat(inputs[i].c_str(), &status) == 0 ? status.st_size : 0);
+        tasks.push_back([&, i]()
+        {
+            {
+                DiagnosticScope scope(&diagnostics[i], inputs[i].c_str());
+                std::shared_ptr<AST_Block> ast;
+                succeeded[i] = compileInput(options, inputs[i], defaultOutputFile(options, inputs[i]), outputs[i],
+                                            ast);
+            }
+
+            // Print every finished input whose predecessors are all printed.
+            std::lock_guard<std::mutex> lock(printMutex);
+            done[i] = true;
+            while (printed < count && done[printed])
+            {
+                fputs(diagnostics[printed].c_str(), stderr);
+                printed++;
+            }
+        });
+    }
+    runWorkStealing(tasks, costs, jobs);
+
+    bool ok = true;
+    for (size_t i = 0; i < count; i++)
+    {
+        ok = ok && succeeded[i];
+        files.insert(files.end(), outputs[i].begin(), outputs[i].end());
+    }
+    return ok;
+}
+
+/*
+ * compile: the whole command line compiler, also run by daemon workers.
+ */
+static int compile(int argc, char **argv)
 {
     // Check for the right # of arguments.
     if (argc >= 2)
@@ -42,76 +230,261 @@ int main(int argc, char **argv)
             return EXIT_SUCCESS;
         }
         // Parse from command line input.
+        Options options;
+        bool TimeReport = false;
+        std::string TimeTraceFile;
+        std::string DumpASTJsonFile;
+        std::string DumpASTDir;
+        bool CacheStats = false;
+        std::vector<std::string> LinkInputs;
         bool EmitLLVM = false;
         bool OutputName = false;
-        std::string InputFile;
+        std::vector<std::string> InputFiles;
         for (int i = 1; i < argc; i++)
         {
             if (strcmp(argv[i], "-c") == 0)
             {
-                DontLink = true;
+                options.DontLink = true;
             } else if (strcmp(argv[i], "-o") == 0)
             {
-                OutputFile = std::string(argv[i + 1]);
+                options.OutputFile = std::string(argv[i + 1]);
                 OutputName = true;
                 i++;
             } else if (strcmp(argv[i], "-S") == 0)
             {
-                DontLink = true;
-                EmitASM = true;
+                options.DontLink = true;
+                options.EmitASM = true;
             } else if (strcmp(argv[i], "-emit-llvm") == 0)
             {
                 EmitLLVM = true;
+            } else if (strcmp(argv[i], "-emit-ast") == 0)
+            {
+                options.EmitAST = true;
+                options.DontLink = true;
+            } else if (strcmp(argv[i], "-save-temps") == 0)
+            {
+                options.SaveTemps = true;
+            } else if (strcmp(argv[i], "-j") == 0)
+            {
+                options.OptimizationThreads = (unsigned) atoi(argv[i + 1]);
+                i++;
+            } else if (strncmp(argv[i], "-j", 2) == 0)
+            {
+                options.OptimizationThreads = (unsigned) atoi(argv[i] + 2);
+            } else if (strncmp(argv[i], "-fcodegen-partitions=", 21) == 0)
+            {
+                options.CodeGenPartitions = (unsigned) std::max(1, atoi(argv[i] + 21));
+            } else if (strcmp(argv[i], "-fprofile-generate") == 0)
+            {
+                options.ProfileGenerate = true;
+            } else if (strncmp(argv[i], "-fprofile-generate=", 19) == 0)
+            {
+                options.ProfileGenerate = true;
+                options.ProfileGenerateDir = std::string(argv[i] + 19);
+            } else if (strncmp(argv[i], "-fprofile-use=", 14) == 0)
+            {
+                options.ProfileUseFile = std::string(argv[i] + 14);
+            } else if (strcmp(argv[i], "-target") == 0)
+            {
+                options.TargetTripleName = std::string(argv[i + 1]);
+                i++;
+            } else if (strncmp(argv[i], "-march=", 7) == 0)
+            {
+                options.TargetCPU = std::string(argv[i] + 7);
+            } else if (strncmp(argv[i], "-mcpu=", 6) == 0)
+            {
+                options.TargetCPU = std::string(argv[i] + 6);
+            } else if (strncmp(argv[i], "-mattr=", 7) == 0)
+            {
+                // Multiple -mattr options accumulate.
+                if (!options.TargetFeatures.empty())
+                {
+                    options.TargetFeatures += ",";
+                }
+                options.TargetFeatures += std::string(argv[i] + 7);
+            } else if (strncmp(argv[i], "-mtune=", 7) == 0)
+            {
+                options.TargetTuneCPU = std::string(argv[i] + 7);
             } else if (argv[i][0] == '-' && argv[i][1] == 'O')
             {
                 // Optimization level.
-                OptimizationLevel = std::string(argv[i]);
+                options.OptimizationLevel = std::string(argv[i]);
+            } else if (strcmp(argv[i], "-fno-ast-fold") == 0)
+            {
+                options.FoldAST = false;
+            } else if (strcmp(argv[i], "-ast-fold-stats") == 0)
+            {
+                options.FoldASTStats = true;
+            } else if (strcmp(argv[i], "-fmir") == 0)
+            {
+                options.MIR = true;
+            } else if (strcmp(argv[i], "-fbounds-check") == 0)
+            {
+                options.MIR = true;
+                options.BoundsCheck = true;
+            } else if (strcmp(argv[i], "-mir-stats") == 0)
+            {
+                options.MIRStats = true;
+            } else if (strcmp(argv[i], "-dump-mir") == 0)
+            {
+                options.DumpMIR = true;
+            } else if (strcmp(argv[i], "-ftime-report") == 0)
+            {
+                TimeReport = true;
+            } else if (strncmp(argv[i], "-ftime-trace=", 13) == 0)
+            {
+                TimeTraceFile = std::string(argv[i] + 13);
+            } else if (strncmp(argv[i], "-dump-ast-json=", 15) == 0)
+            {
+                DumpASTJsonFile = std::string(argv[i] + 15);
+            } else if (strncmp(argv[i], "-dump-ast-dir=", 14) == 0)
+            {
+                DumpASTDir = std::string(argv[i] + 14);
+            } else if (strncmp(argv[i], "-Rpass=", 7) == 0)
+            {
+                options.RemarksPassed = std::string(argv[i] + 7);
+            } else if (strncmp(argv[i], "-Rpass-missed=", 14) == 0)
+            {
+                options.RemarksMissed = std::string(argv[i] + 14);
+            } else if (strncmp(argv[i], "-Rpass-analysis=", 16) == 0)
+            {
+                options.RemarksAnalysis = std::string(argv[i] + 16);
+            } else if (strcmp(argv[i], "-fsave-optimization-record") == 0)
+            {
+                options.SaveOptimizationRecord = true;
+            } else if (strncmp(argv[i], "-foptimization-record-file=", 27) == 0)
+            {
+                options.SaveOptimizationRecord = true;
+                options.OptimizationRecordFile = std::string(argv[i] + 27);
+            } else if (strcmp(argv[i], "-flto=thin") == 0)
+            {
+                options.ThinLTO = true;
+            } else if (strncmp(argv[i], "-fcache-dir=", 12) == 0)
+            {
+                options.CacheDir = std::string(argv[i] + 12);
+            } else if (strncmp(argv[i], "-fcache-max-size=", 17) == 0)
+            {
+                // A number of MiB whose byte count fits, a typo must not prune the whole cache.
+                const char *value = argv[i] + 17;
+                char *end;
+                errno = 0;
+                unsigned long long size = strtoull(value, &end, 10);
+                if (!isdigit((unsigned char) *value) || *end || errno == ERANGE || size > (UINT64_MAX >> 20))
+                {
+                    fprintf(stderr, "slang:\033[1;31m error:\033[0m invalid cache size in argument '%s'\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+                options.CacheMaxSize = (uint64_t) size << 20;
+            } else if (strcmp(argv[i], "-cache-stats") == 0)
+            {
+                CacheStats = true;
+            } else if (strncmp(argv[i], "-fuse-ld=", 9) == 0)
+            {
+                options.UseLinker = std::string(argv[i] + 9);
+                if (options.UseLinker != "lld" && options.UseLinker != "clang")
+                {
+                    fprintf(stderr, "slang:\033[1;31m error:\033[0m invalid linker name in argument '%s'\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+            } else if (strncmp(argv[i], "-crt-dir=", 9) == 0)
+            {
+                options.CRTDir = std::string(argv[i] + 9);
+            } else if (strncmp(argv[i], "-gcc-runtime-dir=", 17) == 0)
+            {
+                options.GCCRuntimeDir = std::string(argv[i] + 17);
+            } else if (strncmp(argv[i], "-dynamic-linker=", 16) == 0)
+            {
+                options.DynamicLinker = std::string(argv[i] + 16);
+            } else if (strncmp(argv[i], "-L", 2) == 0)
+            {
+                options.LibraryDirs.push_back(std::string(argv[i] + 2));
+            } else if (isLinkInput(argv[i]))
+            {
+                // Object or bitcode file, only used by the link step.
+                LinkInputs.push_back(std::string(argv[i]));
             } else
             {
                 // Input file.
-                InputFile = std::string(argv[i]);
-                size_t pos = InputFile.find(".");
-                Prefix = InputFile.substr(0, pos);
+                InputFiles.push_back(std::string(argv[i]));
             }
         }
 
-        if (EmitLLVM && DontLink)
+        if (CacheStats && options.CacheDir.empty())
         {
-            if (EmitASM)
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m -cache-stats requires -fcache-dir=<dir>\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (CacheStats && InputFiles.empty() && LinkInputs.empty())
+        {
+            printCacheStats(options);
+            return EXIT_SUCCESS;
+        }
+
+        if (InputFiles.empty() && LinkInputs.empty())
+        {
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m no input files\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (EmitLLVM && options.DontLink)
+        {
+            if (options.EmitASM)
             {
-                EmitIR = true;
-                EmitASM = false;
+                options.EmitIR = true;
+                options.EmitASM = false;
             } else
             {
-                EmitBC = true;
+                options.EmitBC = true;
             }
-        } else if (EmitLLVM && !DontLink)
+        } else if (EmitLLVM && !options.DontLink)
         {
             fprintf(stderr, "slang:\033[1;31m error:\033[0m -emit-llvm cannot be used when linking\n");
             exit(EXIT_FAILURE);
         }
 
+        if (options.EmitAST && (EmitLLVM || options.EmitASM))
+        {
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m -emit-ast cannot be combined with -S or -emit-llvm\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (OutputName && options.DontLink && InputFiles.size() > 1)
+        {
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot specify -o when generating multiple output files\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if (!DumpASTJsonFile.empty() || !DumpASTDir.empty())
+        {
+            if (InputFiles.size() != 1)
+            {
+                fprintf(stderr, "slang:\033[1;31m error:\033[0m -dump-ast-json and -dump-ast-dir require exactly one "
+                                "source input\n");
+                exit(EXIT_FAILURE);
+            }
+            // A cache hit has no AST.
+            options.CacheDir.clear();
+        }
+
+        if (options.ProfileGenerate && !options.ProfileUseFile.empty())
+        {
+            fprintf(stderr, "slang:\033[1;31m error:\033[0m -fprofile-generate and -fprofile-use are exclusive\n");
+            exit(EXIT_FAILURE);
+        }
+
         if (!OutputName)
         {
             // Give output file its default name.
-            if (DontLink)
+            if (options.DontLink)
             {
-                if (EmitASM)
+                if (InputFiles.size() == 1)
                 {
-                    OutputFile = Prefix + ".s";
-                } else if (EmitBC)
-                {
-                    OutputFile = Prefix + ".bc";
-                } else if (EmitIR)
-                {
-                    OutputFile = Prefix + ".ll";
-                } else
-                {
-                    OutputFile = Prefix + ".o";
+                    options.OutputFile = defaultOutputFile(options, InputFiles.front());
                 }
             } else
             {
-                OutputFile = "a.out";
+                options.OutputFile = "a.out";
             }
         }
 
@@ -120,35 +493,102 @@ int main(int argc, char **argv)
         std::cout << "EmitIR = " << std::boolalpha << EmitIR << std::endl;
         std::cout << "EmitASM = " << std::boolalpha << EmitASM << std::endl;
         std::cout << "EmitBC = " << std::boolalpha << EmitBC << std::endl;
-        std::cout << "InputFile = " << InputFile << std::endl;
-        std::cout << "Prefix = " << Prefix << std::endl;
+        std::cout << "InputFiles = " << InputFiles.size() << std::endl;
         std::cout << "OutputFile = " << OutputFile << std::endl;
         std::cout << "OptimizationLevel = " << OptimizationLevel << std::endl;
 #endif
 
-        // Compile from an input file.
-        Driver driver;
-        yyfile = InputFile.c_str();
-        driver.parse(InputFile);
-        if (!emptyFile)
+        if (TimeReport || !TimeTraceFile.empty())
         {
-            // You may need to link obj files manually here.
-            if (!DontLink)
+            startTimeReport(TimeReport);
+        }
+
+        // -j spreads the inputs over threads when there are several, else the functions of the one input.
+        unsigned jobs = options.OptimizationThreads;
+        std::vector<std::string> compiledFiles;
+        std::shared_ptr<AST_Block> programBlock;
+        if (InputFiles.size() == 1)
+        {
+            if (!compileInput(options, InputFiles.front(), options.OutputFile, compiledFiles, programBlock))
+            {
+                exit(EXIT_FAILURE);
+            }
+            if (!DumpASTJsonFile.empty() && !dumpASTJson(programBlock, DumpASTJsonFile))
+            {
+                exit(EXIT_FAILURE);
+            }
+            if (!DumpASTDir.empty() && !dumpASTChunks(programBlock, DumpASTDir, InputFiles.front()))
             {
-                std::string command = std::string("clang") + " output.o -o " + OutputFile;
-                system(command.c_str());
-                system("rm output.o");
+                exit(EXIT_FAILURE);
             }
+            programBlock = nullptr;
+        } else if (InputFiles.size() > 1)
+        {
+            options.OptimizationThreads = 0;
+            if (!compileInputs(options, InputFiles, std::max(jobs, 1u), compiledFiles))
+            {
+                if (!options.DontLink)
+                {
+                    for (auto &file : compiledFiles)
+                    {
+                        remove(file.c_str());
+                    }
+                }
+                exit(EXIT_FAILURE);
+            }
+        }
+        bool compiled = !compiledFiles.empty();
 
-            // Visualization.
-            auto root = programBlock->generateJson();
-            std::string jsonFile = "../visualization/visualization.json";
-            std::ofstream os(jsonFile);
-            if (os.is_open())
+        // You may need to link obj files manually here.
+        if (!options.DontLink && (compiled || !LinkInputs.empty()))
+        {
+            std::vector<std::string> objects = compiledFiles;
+            std::vector<std::string> temporaries = compiledFiles;
+            objects.insert(objects.end(), LinkInputs.begin(), LinkInputs.end());
+
+            if (options.ThinLTO)
             {
-                os << root;
-                os.close();
+                // Cross-module importing, optimization and code generation happen here.
+                TimeRegion region("ThinLTO backend");
+                auto natives = thinLink(objects, options.OutputFile, jobs, options);
+                for (auto &native : natives)
+                {
+                    if (std::find(objects.begin(), objects.end(), native) == objects.end())
+                    {
+                        temporaries.push_back(native);
+                    }
+                }
+                objects = natives;
             }
+
+            TimeRegion region("Link");
+            if (!linkExecutable(objects, options.OutputFile, options))
+            {
+                fprintf(stderr, "slang:\033[1;31m error:\033[0m linker command failed\n");
+                for (auto &temporary : temporaries)
+                {
+                    remove(temporary.c_str());
+                }
+                exit(EXIT_FAILURE);
+            }
+            for (auto &temporary : temporaries)
+            {
+                remove(temporary.c_str());
+            }
+        }
+
+        if (CacheStats)
+        {
+            printCacheStats(options);
+        }
+
+        if (TimeReport)
+        {
+            printTimeReport();
+        }
+        if (!TimeTraceFile.empty())
+        {
+            writeTimeTrace(TimeTraceFile);
         }
     } else
     {
@@ -158,3 +598,16 @@ int main(int argc, char **argv)
 
     return EXIT_SUCCESS;
 }
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && (strcmp(argv[1], "-daemon") == 0 || strncmp(argv[1], "-daemon=", 8) == 0))
+    {
+        // Pay for LLVM's start-up once: loading, relocation and target registration are inherited by every worker.
+        Options options;
+        initializeTargetRegistry(options);
+        std::string socketPath = argv[1][7] == '=' ? std::string(argv[1] + 8) : defaultSocketPath();
+        return runDaemon(socketPath, compile);
+    }
+    return compile(argc, argv);
+}
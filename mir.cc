@@ -0,0 +1,1113 @@
+#include <iomanip>
+#include <llvm/Support/raw_ostream.h>
+#include "IR.h"
+#include "mir.h"
+
+namespace mir
+{
+
+namespace
+{
+
+/*
+ * Lowering: one walk over the AST in the order IR generation takes, on the
+ * names and types the semantic analysis has resolved. Every construct is
+ * checked against what IR generation from the AST would do with it, the first
+ * one it would report, or compile to something other than what it means,
+ * stops the lowering.
+ */
+class Lowering
+{
+public:
+    Lowering(CodeGenContext &context, bool boundsChecks, Module &module) :
+            context(context), boundsChecks(boundsChecks), module(module)
+    {}
+
+    std::string reason;
+
+    bool lowerProgram(AST_Block &programBlock)
+    {
+        for (auto &statement : *programBlock.statements)
+        {
+            if (!lowerGlobalStatement(*statement))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    CodeGenContext &context;
+    bool boundsChecks;
+    Module &module;
+    Function *function = nullptr;
+    // Location of the statement being lowered, IR generation locates instructions by statement.
+    Location location = {0, 0};
+    // Blocks entered in the function, only a return in its own block counts.
+    unsigned depth = 0;
+    uint32_t returnValue = None;
+
+    bool fail(const AST_Node &node, const std::string &message)
+    {
+        reason = std::to_string(node.row) + ":" + std::to_string(node.col) + ": " + message;
+        return false;
+    }
+
+    uint32_t failValue(const AST_Node &node, const std::string &message)
+    {
+        fail(node, message);
+        return None;
+    }
+
+    uint32_t emit(Opcode opcode, ValueType type, uint32_t a = None, uint32_t b = None, uint32_t c = None,
+                  uint8_t op = 0)
+    {
+        function->instructions.push_back(Instruction{opcode, type, op, a, b, c});
+        function->locations.push_back(location);
+        return (uint32_t) function->instructions.size() - 1;
+    }
+
+    uint32_t newBlock(BlockKind kind)
+    {
+        function->blocks.push_back(kind);
+        return (uint32_t) function->blocks.size() - 1;
+    }
+
+    void label(uint32_t block)
+    {
+        emit(Opcode::Label, ValueType::None, None, None, block);
+    }
+
+    void branch(uint32_t block)
+    {
+        emit(Opcode::Branch, ValueType::None, None, None, block);
+    }
+
+    ValueType typeOf(uint32_t value) const
+    {
+        return resultType(function->instructions[value]);
+    }
+
+    ValueType valueTypeOf(llvm::Type *type) const
+    {
+        const TypeSystem &types = context.typeSystem;
+        if (type == types.boolTy)
+        {
+            return ValueType::Bool;
+        } else if (type == types.charTy)
+        {
+            return ValueType::Char;
+        } else if (type == types.intTy)
+        {
+            return ValueType::Int;
+        } else if (type == types.floatTy)
+        {
+            return ValueType::Float;
+        } else if (type == types.doubleTy)
+        {
+            return ValueType::Double;
+        } else if (type == types.stringTy)
+        {
+            return ValueType::String;
+        }
+        return ValueType::None;
+    }
+
+    static bool isInteger(ValueType type)
+    {
+        return type == ValueType::Bool || type == ValueType::Char || type == ValueType::Int;
+    }
+
+    static bool isScalar(ValueType type)
+    {
+        return type != ValueType::None && type != ValueType::Address;
+    }
+
+    const Variable *variableOf(const AST_Identifier &identifier) const
+    {
+        Symbol *symbol = identifier.symbol;
+        return symbol && symbol->mirIndex != None ? &module.variables[symbol->mirIndex] : nullptr;
+    }
+
+    uint32_t addressOf(const AST_Identifier &identifier)
+    {
+        Symbol *symbol = identifier.symbol;
+        if (module.variables[symbol->mirIndex].kind == VariableKind::Global)
+        {
+            return emit(Opcode::Global, ValueType::Address, None, None, symbol->mirIndex);
+        }
+        return symbol->mirAddress;
+    }
+
+    /*
+     * declare: add the variable of declaration, the way IR generation allocates it.
+     */
+    bool declare(const AST_VariableDeclaration &declaration, VariableKind kind)
+    {
+        const AST_Identifier &type = *declaration.type;
+        llvm::Type *llvmType = type.resolvedType;
+        if (!llvmType || llvmType->isVoidTy())
+        {
+            return fail(type, "variable of type '" + type.name + "'");
+        }
+        Variable variable;
+        variable.name = declaration.id->name;
+        variable.kind = kind;
+        variable.type = llvmType;
+        variable.valueType = type.isArray ? ValueType::None : valueTypeOf(llvmType);
+        variable.firstDimension = (uint32_t) module.dimensions.size();
+        variable.dimensions = 0;
+        variable.elements = 1;
+        if (type.isArray && kind == VariableKind::Parameter)
+        {
+            // A pointer to the first element, of unknown dimensions.
+            variable.valueType = ValueType::Address;
+        } else if (type.isArray)
+        {
+            for (auto &size : *type.arraySize)
+            {
+                if (size->getKind() != ASTKind::Integer)
+                {
+                    return fail(*size, "array dimension is not an integer literal");
+                }
+                uint64_t dimension = static_cast<const AST_Integer &>(*size).value;
+                module.dimensions.push_back(dimension);
+                variable.dimensions++;
+                variable.elements *= dimension;
+            }
+        }
+        // CodeGenContext::getInitial only has a zero of the right type for these.
+        if (kind == VariableKind::Global && !type.isArray && variable.valueType != ValueType::Int &&
+            variable.valueType != ValueType::Double)
+        {
+            return fail(type, "global variable of type '" + type.name + "'");
+        }
+
+        Symbol *symbol = declaration.id->symbol;
+        symbol->mirIndex = (uint32_t) module.variables.size();
+        module.variables.push_back(variable);
+        symbol->mirAddress = kind == VariableKind::Global ? None : emit(Opcode::Local, ValueType::Address, None,
+                                                                         None, symbol->mirIndex);
+        return true;
+    }
+
+    bool lowerGlobalStatement(AST_Statement &statement)
+    {
+        location = {statement.row, statement.col};
+        switch (statement.getKind())
+        {
+            case ASTKind::VariableDeclaration:
+            {
+                auto &declaration = static_cast<AST_VariableDeclaration &>(statement);
+                if (declaration.assignmentExpr)
+                {
+                    // IR generation has no function to put the assignment in.
+                    return fail(declaration, "initializer of a global variable");
+                }
+                return declare(declaration, VariableKind::Global);
+            }
+            case ASTKind::FunctionDeclaration:
+                return lowerFunction(static_cast<AST_FunctionDeclaration &>(statement));
+            case ASTKind::StructDeclaration:
+                return true;
+            default:
+                return fail(statement, std::string(statement.getTypeName()) + " outside of a function");
+        }
+    }
+
+    bool lowerFunction(AST_FunctionDeclaration &declaration)
+    {
+        Symbol *symbol = declaration.id->symbol;
+        uint32_t index = (uint32_t) module.functions.size();
+        module.functions.emplace_back();
+        function = &module.functions.back();
+        function->name = declaration.id->name;
+        function->location = {declaration.id->row, declaration.id->col};
+        function->isExternal = declaration.isExternal;
+        function->target = index;
+        function->returnType = declaration.type->isArray ? nullptr : declaration.type->resolvedType;
+        if (!function->returnType ||
+            (!function->returnType->isVoidTy() && valueTypeOf(function->returnType) == ValueType::None))
+        {
+            return fail(*declaration.type, "function returning '" + declaration.type->name + "'");
+        }
+        for (auto &argument : *declaration.arguments)
+        {
+            const AST_Identifier &type = *argument->type;
+            if (!type.resolvedType || (!type.isArray && valueTypeOf(type.resolvedType) == ValueType::None))
+            {
+                return fail(type, "parameter of type '" + type.name + "'");
+            }
+            function->parameterTypes.push_back(type.isArray ? llvm::PointerType::get(type.resolvedType, 0)
+                                                            : type.resolvedType);
+            function->parameterNames.push_back(argument->id->name);
+        }
+
+        // Calls go to the first declaration, a definition fills in its llvm::Function.
+        if (symbol->mirIndex == None)
+        {
+            symbol->mirIndex = index;
+        } else if (!declaration.isExternal)
+        {
+            const Function &prototype = module.functions[symbol->mirIndex];
+            for (auto &other : module.functions)
+            {
+                if (&other != function && !other.isExternal && other.target == symbol->mirIndex)
+                {
+                    return fail(*declaration.id, "redefinition of '" + function->name + "'");
+                }
+            }
+            if (prototype.returnType != function->returnType || prototype.parameterTypes != function->parameterTypes)
+            {
+                return fail(*declaration.id, "definition of '" + function->name + "' differs from its prototype");
+            }
+            function->target = symbol->mirIndex;
+        }
+        if (declaration.isExternal)
+        {
+            return true;
+        }
+
+        location = function->location;
+        label(newBlock(BlockKind::Entry));
+        for (size_t i = 0; i < declaration.arguments->size(); i++)
+        {
+            AST_VariableDeclaration &argument = *declaration.arguments->at(i);
+            if (!declare(argument, VariableKind::Parameter))
+            {
+                return false;
+            }
+            Symbol *parameter = argument.id->symbol;
+            uint32_t value = emit(Opcode::Argument, module.variables[parameter->mirIndex].valueType, None, None,
+                                  (uint32_t) i);
+            emit(Opcode::Store, ValueType::None, parameter->mirAddress, value);
+        }
+
+        depth = 0;
+        returnValue = None;
+        if (!lowerStatements(*declaration.block))
+        {
+            return false;
+        }
+        if (returnValue == None)
+        {
+            return fail(*declaration.block, "control reaches end with no return value");
+        }
+        if (typeOf(returnValue) != valueTypeOf(function->returnType))
+        {
+            return fail(*declaration.block, "return value of the wrong type");
+        }
+        emit(Opcode::Return, ValueType::None, returnValue);
+        return true;
+    }
+
+    bool lowerStatements(AST_Block &block)
+    {
+        for (auto &statement : *block.statements)
+        {
+            location = {statement->row, statement->col};
+            if (!lowerStatement(*statement))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * lowerScope: the statements of a block that IR generation gives a CodeGenBlock of its own.
+     */
+    bool lowerScope(AST_Block &block)
+    {
+        depth++;
+        bool lowered = lowerStatements(block);
+        depth--;
+        return lowered;
+    }
+
+    bool lowerStatement(AST_Statement &statement)
+    {
+        switch (statement.getKind())
+        {
+            case ASTKind::ExpressionStatement:
+            {
+                auto &expression = static_cast<AST_ExpressionStatement &>(statement).expression;
+                return expression ? lowerEffect(*expression) : fail(statement, "statement without an expression");
+            }
+            case ASTKind::VariableDeclaration:
+            {
+                auto &declaration = static_cast<AST_VariableDeclaration &>(statement);
+                if (!declare(declaration, VariableKind::Local))
+                {
+                    return false;
+                }
+                return !declaration.assignmentExpr || lowerAssignment(*declaration.id, *declaration.assignmentExpr);
+            }
+            case ASTKind::ArrayInitialization:
+                return lowerArrayInitialization(static_cast<AST_ArrayInitialization &>(statement));
+            case ASTKind::ReturnStatement:
+            {
+                // `return;` has an AST_Expression, which has no value.
+                uint32_t value = lowerValue(*static_cast<AST_ReturnStatement &>(statement).expression);
+                if (value == None)
+                {
+                    return false;
+                }
+                // The return value of a nested block is dropped with it.
+                if (depth == 0)
+                {
+                    returnValue = value;
+                }
+                return true;
+            }
+            case ASTKind::IfStatement:
+                return lowerIf(static_cast<AST_IfStatement &>(statement));
+            case ASTKind::ForStatement:
+                return lowerFor(static_cast<AST_ForStatement &>(statement));
+            default:
+                return fail(statement, std::string(statement.getTypeName()) + " inside a function");
+        }
+    }
+
+    uint32_t lowerCondition(AST_Expression &expression)
+    {
+        uint32_t value = lowerValue(expression);
+        if (value == None)
+        {
+            return None;
+        }
+        // CastToBoolean passes anything else through to the branch.
+        if (!isInteger(typeOf(value)) && typeOf(value) != ValueType::Double)
+        {
+            return failValue(expression, "condition is not a number");
+        }
+        return emit(Opcode::ToBool, ValueType::Bool, value);
+    }
+
+    bool lowerIf(AST_IfStatement &statement)
+    {
+        uint32_t condition = lowerCondition(*statement.condition);
+        if (condition == None)
+        {
+            return false;
+        }
+        uint32_t thenBlock = newBlock(BlockKind::Then);
+        uint32_t elseBlock = statement.falseBlock ? newBlock(BlockKind::Else) : None;
+        uint32_t endBlock = newBlock(BlockKind::IfEnd);
+        emit(Opcode::CondBranch, ValueType::None, condition, thenBlock, statement.falseBlock ? elseBlock : endBlock);
+
+        label(thenBlock);
+        if (!lowerScope(*statement.trueBlock))
+        {
+            return false;
+        }
+        branch(endBlock);
+        if (statement.falseBlock)
+        {
+            label(elseBlock);
+            if (!lowerScope(*statement.falseBlock))
+            {
+                return false;
+            }
+            branch(endBlock);
+        }
+        label(endBlock);
+        return true;
+    }
+
+    bool lowerFor(AST_ForStatement &statement)
+    {
+        if (!statement.condition)
+        {
+            return fail(statement, "loop without a condition");
+        }
+        Loop loop;
+        loop.atLeastOnce = statement.atLeastOnce;
+        loop.initialBegin = (uint32_t) function->instructions.size();
+        if (statement.initial && !lowerEffect(*statement.initial))
+        {
+            return false;
+        }
+        uint32_t bodyBlock = newBlock(BlockKind::Loop);
+        uint32_t endBlock = newBlock(BlockKind::LoopEnd);
+        if (statement.atLeastOnce)
+        {
+            // The test is evaluated, and the body entered whatever it gives.
+            if (lowerValue(*statement.condition) == None)
+            {
+                return false;
+            }
+            branch(bodyBlock);
+        } else
+        {
+            uint32_t condition = lowerCondition(*statement.condition);
+            if (condition == None)
+            {
+                return false;
+            }
+            emit(Opcode::CondBranch, ValueType::None, condition, bodyBlock, endBlock);
+        }
+
+        loop.bodyBegin = (uint32_t) function->instructions.size();
+        label(bodyBlock);
+        if (!lowerScope(*statement.block))
+        {
+            return false;
+        }
+        loop.bodyEnd = (uint32_t) function->instructions.size();
+        if (statement.increment && !lowerEffect(*statement.increment))
+        {
+            return false;
+        }
+        uint32_t condition = lowerCondition(*statement.condition);
+        if (condition == None)
+        {
+            return false;
+        }
+        loop.latch = emit(Opcode::CondBranch, ValueType::None, condition, bodyBlock, endBlock);
+        label(endBlock);
+        function->loops.push_back(loop);
+        return true;
+    }
+
+    /*
+     * lowerEffect: an expression whose value is not used, the only place an assignment may be.
+     */
+    bool lowerEffect(AST_Expression &expression)
+    {
+        switch (expression.getKind())
+        {
+            case ASTKind::Expression:
+                // The empty statement.
+                return true;
+            case ASTKind::Assignment:
+            {
+                auto &assignment = static_cast<AST_Assignment &>(expression);
+                return lowerAssignment(*assignment.lhs, *assignment.rhs);
+            }
+            case ASTKind::ArrayAssignment:
+            {
+                auto &assignment = static_cast<AST_ArrayAssignment &>(expression);
+                ValueType elementType;
+                uint32_t address = lowerElementAddress(*assignment.arrayIndex, elementType);
+                return address != None && lowerStore(address, elementType, *assignment.expression);
+            }
+            case ASTKind::StructAssignment:
+            {
+                auto &assignment = static_cast<AST_StructAssignment &>(expression);
+                ValueType memberType;
+                uint32_t address = lowerMemberAddress(*assignment.structMember, memberType);
+                return address != None && lowerStore(address, memberType, *assignment.expression);
+            }
+            case ASTKind::MethodCall:
+                return lowerCall(static_cast<AST_MethodCall &>(expression), false) != None;
+            default:
+                return lowerValue(expression) != None;
+        }
+    }
+
+    bool lowerAssignment(AST_Identifier &lhs, AST_Expression &rhs)
+    {
+        const Variable *variable = variableOf(lhs);
+        if (!variable)
+        {
+            return fail(lhs, "use of undeclared identifier '" + lhs.name + "'");
+        }
+        if (!isScalar(variable->valueType))
+        {
+            return fail(lhs, "assignment to '" + lhs.name + "', which is not a scalar");
+        }
+        ValueType target = variable->valueType;
+        uint32_t address = addressOf(lhs);
+        uint32_t value = lowerValue(rhs);
+        if (value == None)
+        {
+            return false;
+        }
+        // The conversions of the cast table in TypeSystem, it leaves any other mismatch as it is.
+        ValueType source = typeOf(value);
+        if (source != target)
+        {
+            ConvertOp op;
+            if ((source == ValueType::Int && (target == ValueType::Float || target == ValueType::Double)) ||
+                (source == ValueType::Bool && target == ValueType::Double))
+            {
+                op = ConvertOp::SIToFP;
+            } else if (source == ValueType::Float && target == ValueType::Double)
+            {
+                op = ConvertOp::FPExt;
+            } else if ((source == ValueType::Float || source == ValueType::Double) && target == ValueType::Int)
+            {
+                op = ConvertOp::FPToSI;
+            } else
+            {
+                return fail(rhs, "assignment of a value that does not convert");
+            }
+            value = emit(Opcode::Convert, target, value, None, None, (uint8_t) op);
+        }
+        emit(Opcode::Store, ValueType::None, address, value);
+        return true;
+    }
+
+    /*
+     * lowerStore: an element or member assignment, which stores the value without a conversion.
+     */
+    bool lowerStore(uint32_t address, ValueType type, AST_Expression &expression)
+    {
+        uint32_t value = lowerValue(expression);
+        if (value == None)
+        {
+            return false;
+        }
+        if (typeOf(value) != type)
+        {
+            return fail(expression, "stored value of the wrong type");
+        }
+        emit(Opcode::Store, ValueType::None, address, value);
+        return true;
+    }
+
+    /*
+     * lowerElementAddress: the address of an array element, and its type in elementType.
+     */
+    uint32_t lowerElementAddress(AST_ArrayIndex &index, ValueType &elementType)
+    {
+        const AST_Identifier &name = *index.arrayName;
+        const Variable *variable = variableOf(name);
+        if (!variable)
+        {
+            return failValue(name, "use of undeclared identifier '" + name.name + "'");
+        }
+        // calcArrayIndex has no dimensions for an array parameter.
+        if (variable->dimensions == 0)
+        {
+            return failValue(name, "subscripted value is not an array of known dimensions");
+        }
+        if (index.expressions->size() != variable->dimensions)
+        {
+            return failValue(name, "subscripts do not match the dimensions of '" + name.name + "'");
+        }
+        elementType = valueTypeOf(variable->type);
+        uint32_t variableIndex = name.symbol->mirIndex;
+        uint32_t firstDimension = variable->firstDimension;
+        uint32_t address = addressOf(name);
+
+        std::vector<uint32_t> indices;
+        for (size_t i = 0; i < index.expressions->size(); i++)
+        {
+            AST_Expression &expression = *index.expressions->at(i);
+            uint32_t value = lowerValue(expression);
+            if (value == None)
+            {
+                return None;
+            }
+            if (typeOf(value) != ValueType::Int)
+            {
+                return failValue(expression, "array subscript is not an int");
+            }
+            if (boundsChecks)
+            {
+                emit(Opcode::CheckIndex, ValueType::None, value, None,
+                     (uint32_t) module.dimensions[firstDimension + i]);
+            }
+            indices.push_back(value);
+        }
+
+        // Row-major, as calcArrayIndex computes it.
+        uint32_t flat = indices.back();
+        uint64_t stride = module.dimensions[firstDimension + indices.size() - 1];
+        for (size_t i = indices.size() - 1; i >= 1; i--)
+        {
+            uint32_t scale = emit(Opcode::ConstInt, ValueType::Int, None, None, (uint32_t) stride);
+            uint32_t scaled = emit(Opcode::Binary, ValueType::Int, scale, indices[i - 1], None,
+                                   (uint8_t) BinaryOp::Mul);
+            flat = emit(Opcode::Binary, ValueType::Int, scaled, flat, None, (uint8_t) BinaryOp::Add);
+            stride *= module.dimensions[firstDimension + i - 1];
+        }
+        return emit(Opcode::ElementAddress, ValueType::Address, address, flat, variableIndex);
+    }
+
+    /*
+     * lowerMemberAddress: the address of a struct member, and its type in memberType.
+     */
+    uint32_t lowerMemberAddress(AST_StructMember &member, ValueType &memberType)
+    {
+        const Variable *variable = variableOf(*member.id);
+        if (!variable)
+        {
+            return failValue(*member.id, "use of undeclared identifier '" + member.id->name + "'");
+        }
+        if (member.isArray)
+        {
+            return failValue(member, "member of an array element");
+        }
+        if (!variable->type->isStructTy() || variable->dimensions != 0 || variable->kind == VariableKind::Parameter)
+        {
+            return failValue(*member.id, "member reference base type '" + member.id->name + "' is not a structure");
+        }
+        if (member.memberIndex < 0)
+        {
+            return failValue(*member.member, "no member named '" + member.member->name + "'");
+        }
+        auto structType = llvm::cast<llvm::StructType>(variable->type);
+        memberType = valueTypeOf(structType->getElementType((unsigned) member.memberIndex));
+        if (memberType == ValueType::None)
+        {
+            return failValue(*member.member, "member '" + member.member->name + "' is not a scalar");
+        }
+        uint32_t address = addressOf(*member.id);
+        return emit(Opcode::MemberAddress, ValueType::Address, address, (uint32_t) member.memberIndex,
+                    member.id->symbol->mirIndex);
+    }
+
+    uint32_t lowerCall(AST_MethodCall &call, bool usedAsValue)
+    {
+        Symbol *symbol = call.id->symbol;
+        if (!symbol || symbol->mirIndex == None)
+        {
+            return failValue(*call.id, "implicit declaration of function '" + call.id->name + "'");
+        }
+        uint32_t callee = symbol->mirIndex;
+        const std::vector<llvm::Type *> &parameterTypes = module.functions[callee].parameterTypes;
+        size_t count = call.arguments ? call.arguments->size() : 0;
+        if (parameterTypes.size() != count)
+        {
+            return failValue(*call.id, "wrong number of arguments in call to '" + call.id->name + "'");
+        }
+        std::vector<uint32_t> arguments;
+        for (size_t i = 0; i < count; i++)
+        {
+            AST_Expression &argument = *call.arguments->at(i);
+            uint32_t value = lowerValue(argument);
+            if (value == None)
+            {
+                return None;
+            }
+            // Arguments are passed as they are.
+            if (typeOf(value) != valueTypeOf(parameterTypes[i]))
+            {
+                return failValue(argument, "argument of the wrong type");
+            }
+            arguments.push_back(value);
+        }
+        llvm::Type *returnType = module.functions[callee].returnType;
+        ValueType type = returnType->isVoidTy() ? ValueType::None : valueTypeOf(returnType);
+        if (usedAsValue && type == ValueType::None)
+        {
+            return failValue(call, "value of a void function");
+        }
+        uint32_t first = (uint32_t) function->operands.size();
+        function->operands.insert(function->operands.end(), arguments.begin(), arguments.end());
+        return emit(Opcode::Call, type, first, (uint32_t) count, callee);
+    }
+
+    static bool binaryOp(int token, BinaryOp &op)
+    {
+        switch (token)
+        {
+            case ADD_OP:
+                op = BinaryOp::Add;
+                return true;
+            case SUB_OP:
+                op = BinaryOp::Sub;
+                return true;
+            case MUL_OP:
+                op = BinaryOp::Mul;
+                return true;
+            case DIV_OP:
+                op = BinaryOp::Div;
+                return true;
+            case AND_OP:
+            case BIT_AND_OP:
+                op = BinaryOp::And;
+                return true;
+            case OR_OP:
+            case BIT_OR_OP:
+                op = BinaryOp::Or;
+                return true;
+            case BIT_XOR_OP:
+                op = BinaryOp::Xor;
+                return true;
+            case LEFT_OP:
+                op = BinaryOp::Shl;
+                return true;
+            case RIGHT_OP:
+                op = BinaryOp::Shr;
+                return true;
+            case LT_OP:
+                op = BinaryOp::Lt;
+                return true;
+            case LE_OP:
+                op = BinaryOp::Le;
+                return true;
+            case GE_OP:
+                op = BinaryOp::Ge;
+                return true;
+            case GT_OP:
+                op = BinaryOp::Gt;
+                return true;
+            case EQ_OP:
+                op = BinaryOp::Eq;
+                return true;
+            case NE_OP:
+                op = BinaryOp::Ne;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    uint32_t lowerBinary(AST_BinaryOperator &binary)
+    {
+        uint32_t lhs = lowerValue(*binary.lhs);
+        if (lhs == None)
+        {
+            return None;
+        }
+        uint32_t rhs = lowerValue(*binary.rhs);
+        if (rhs == None)
+        {
+            return None;
+        }
+        BinaryOp op;
+        if (!binaryOp(binary.op, op))
+        {
+            return failValue(binary, "unknown binary operator");
+        }
+        ValueType left = typeOf(lhs), right = typeOf(rhs);
+        if (left == ValueType::Double || right == ValueType::Double)
+        {
+            // The other operand is converted as unsigned, only integers convert.
+            if ((left != ValueType::Double && !isInteger(left)) || (right != ValueType::Double && !isInteger(right)) ||
+                (op >= BinaryOp::And && op <= BinaryOp::Shr))
+            {
+                return failValue(binary, "invalid operands to binary expression");
+            }
+            if (right != ValueType::Double)
+            {
+                rhs = emit(Opcode::Convert, ValueType::Double, rhs, None, None, (uint8_t) ConvertOp::UIToFP);
+            }
+            if (left != ValueType::Double)
+            {
+                lhs = emit(Opcode::Convert, ValueType::Double, lhs, None, None, (uint8_t) ConvertOp::UIToFP);
+            }
+            return emit(Opcode::Binary, ValueType::Double, lhs, rhs, None, (uint8_t) op);
+        }
+        if (left != right || !isInteger(left))
+        {
+            return failValue(binary, "invalid operands to binary expression");
+        }
+        return emit(Opcode::Binary, left, lhs, rhs, None, (uint8_t) op);
+    }
+
+    uint32_t lowerValue(AST_Expression &expression)
+    {
+        switch (expression.getKind())
+        {
+            case ASTKind::Integer:
+                return emit(Opcode::ConstInt, ValueType::Int, None, None,
+                            (uint32_t) static_cast<AST_Integer &>(expression).value);
+            case ASTKind::Double:
+                module.doubles.push_back(static_cast<AST_Double &>(expression).value);
+                return emit(Opcode::ConstDouble, ValueType::Double, None, None, (uint32_t) module.doubles.size() - 1);
+            case ASTKind::Literal:
+                module.strings.push_back(static_cast<AST_Literal &>(expression).value);
+                return emit(Opcode::ConstString, ValueType::String, None, None, (uint32_t) module.strings.size() - 1);
+            case ASTKind::Identifier:
+            {
+                auto &identifier = static_cast<AST_Identifier &>(expression);
+                const Variable *variable = variableOf(identifier);
+                if (!variable)
+                {
+                    return failValue(identifier, "use of undeclared identifier '" + identifier.name + "'");
+                }
+                // An array decays to a pointer that nothing in the language takes.
+                if (!isScalar(variable->valueType))
+                {
+                    return failValue(identifier, "value of '" + identifier.name + "', which is not a scalar");
+                }
+                return emit(Opcode::Load, variable->valueType, addressOf(identifier));
+            }
+            case ASTKind::BinaryOperator:
+                return lowerBinary(static_cast<AST_BinaryOperator &>(expression));
+            case ASTKind::MethodCall:
+                return lowerCall(static_cast<AST_MethodCall &>(expression), true);
+            case ASTKind::ArrayIndex:
+            {
+                ValueType elementType;
+                uint32_t address = lowerElementAddress(static_cast<AST_ArrayIndex &>(expression), elementType);
+                if (address != None && elementType == ValueType::None)
+                {
+                    return failValue(expression, "value of an element that is not a scalar");
+                }
+                return address == None ? None : emit(Opcode::Load, elementType, address);
+            }
+            case ASTKind::StructMember:
+            {
+                ValueType memberType;
+                uint32_t address = lowerMemberAddress(static_cast<AST_StructMember &>(expression), memberType);
+                return address == None ? None : emit(Opcode::Load, memberType, address);
+            }
+            default:
+                return failValue(expression, std::string("value of ") + expression.getTypeName());
+        }
+    }
+
+    bool lowerArrayInitialization(AST_ArrayInitialization &initialization)
+    {
+        AST_VariableDeclaration &declaration = *initialization.declaration;
+        if (declaration.assignmentExpr || !declaration.type->isArray)
+        {
+            return fail(declaration, "initializer list of a scalar");
+        }
+        if (!declare(declaration, VariableKind::Local))
+        {
+            return false;
+        }
+        uint32_t variableIndex = declaration.id->symbol->mirIndex;
+        const Variable &variable = module.variables[variableIndex];
+        ValueType elementType = valueTypeOf(variable.type);
+        for (size_t i = 0; i < initialization.expressionList->size(); i++)
+        {
+            // The subscripts of element i in AST_ArrayInitialization, each taken modulo its dimension.
+            uint64_t flat = 0;
+            uint64_t stride = 1;
+            for (uint32_t j = variable.dimensions; j-- > 0;)
+            {
+                uint64_t dimension = module.dimensions[variable.firstDimension + j];
+                flat += i / stride % dimension * stride;
+                stride *= dimension;
+            }
+            uint32_t index = emit(Opcode::ConstInt, ValueType::Int, None, None, (uint32_t) flat);
+            uint32_t address = emit(Opcode::ElementAddress, ValueType::Address, addressOf(*declaration.id), index,
+                                    variableIndex);
+            if (!lowerStore(address, elementType, *initialization.expressionList->at(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+const char *typeName(ValueType type)
+{
+    switch (type)
+    {
+        case ValueType::Bool:
+            return "bool";
+        case ValueType::Char:
+            return "char";
+        case ValueType::Int:
+            return "int";
+        case ValueType::Float:
+            return "float";
+        case ValueType::Double:
+            return "double";
+        case ValueType::String:
+            return "string";
+        case ValueType::Address:
+            return "address";
+        default:
+            return "void";
+    }
+}
+
+const char *const BinaryNames[] = {"add", "sub", "mul", "div", "and", "or", "xor", "shl", "shr", "lt", "le", "ge",
+                                   "gt", "eq", "ne"};
+const char *const ConvertNames[] = {"sitofp", "uitofp", "fptosi", "fpext"};
+const char *const BlockNames[] = {"entry", "then", "else", "ifcont", "forloop", "forcont"};
+
+std::string typeName(llvm::Type *type)
+{
+    std::string name;
+    llvm::raw_string_ostream stream(name);
+    type->print(stream);
+    return stream.str();
+}
+
+std::string blockName(const Function &function, uint32_t block)
+{
+    return BlockNames[(int) function.blocks[block]] + (block ? std::to_string(block) : std::string());
+}
+
+bool hasValue(const Instruction &instruction)
+{
+    switch (instruction.opcode)
+    {
+        case Opcode::Nop:
+        case Opcode::Store:
+        case Opcode::CheckIndex:
+        case Opcode::Branch:
+        case Opcode::CondBranch:
+        case Opcode::Return:
+            return false;
+        case Opcode::Call:
+            return instruction.type != ValueType::None;
+        default:
+            return true;
+    }
+}
+
+void printFunction(const Module &module, const Function &function, std::ostream &os)
+{
+    os << (function.isExternal ? "declare " : "define ") << typeName(function.returnType) << " "
+       << function.name << "(";
+    for (size_t i = 0; i < function.parameterTypes.size(); i++)
+    {
+        os << (i ? ", " : "") << typeName(function.parameterTypes[i]) << " "
+           << function.parameterNames[i];
+    }
+    os << ")" << std::endl;
+    if (function.isExternal)
+    {
+        return;
+    }
+
+    int width = (int) std::to_string(function.instructions.size()).size() + 4;
+    for (size_t i = 0; i < function.instructions.size(); i++)
+    {
+        const Instruction &instruction = function.instructions[i];
+        // Removed by a pass.
+        if (instruction.opcode == Opcode::Nop)
+        {
+            continue;
+        }
+        os << std::left << std::setw(width) << (hasValue(instruction) ? "%" + std::to_string(i) + " =" : "")
+           << std::right;
+        switch (instruction.opcode)
+        {
+            case Opcode::Nop:
+                break;
+            case Opcode::Label:
+                os << "label " << blockName(function, instruction.c);
+                break;
+            case Opcode::ConstInt:
+                os << "int " << (int32_t) instruction.c;
+                break;
+            case Opcode::ConstDouble:
+                os << "double " << module.doubles[instruction.c];
+                break;
+            case Opcode::ConstString:
+                os << "string \"" << module.strings[instruction.c] << "\"";
+                break;
+            case Opcode::Argument:
+                os << "argument " << instruction.c;
+                break;
+            case Opcode::Local:
+                os << "local " << module.variables[instruction.c].name;
+                break;
+            case Opcode::Global:
+                os << "global " << module.variables[instruction.c].name;
+                break;
+            case Opcode::Load:
+                os << "load " << typeName(instruction.type) << " %" << instruction.a;
+                break;
+            case Opcode::Store:
+                os << "store %" << instruction.a << ", %" << instruction.b;
+                break;
+            case Opcode::ElementAddress:
+                os << "element " << module.variables[instruction.c].name << " %" << instruction.a << ", %"
+                   << instruction.b;
+                break;
+            case Opcode::MemberAddress:
+                os << "member " << module.variables[instruction.c].name << " %" << instruction.a << ", "
+                   << instruction.b;
+                break;
+            case Opcode::CheckIndex:
+                os << "check %" << instruction.a << " < " << instruction.c;
+                break;
+            case Opcode::Binary:
+                os << BinaryNames[instruction.op] << " " << typeName(instruction.type) << " %" << instruction.a
+                   << ", %" << instruction.b;
+                break;
+            case Opcode::Convert:
+                os << ConvertNames[instruction.op] << " " << typeName(instruction.type) << " %" << instruction.a;
+                break;
+            case Opcode::ToBool:
+                os << "tobool %" << instruction.a;
+                break;
+            case Opcode::Call:
+                os << "call " << typeName(instruction.type) << " " << module.functions[instruction.c].name << "(";
+                for (uint32_t j = 0; j < instruction.b; j++)
+                {
+                    os << (j ? ", %" : "%") << function.operands[instruction.a + j];
+                }
+                os << ")";
+                break;
+            case Opcode::Branch:
+                os << "br " << blockName(function, instruction.c);
+                break;
+            case Opcode::CondBranch:
+                os << "condbr %" << instruction.a << ", " << blockName(function, instruction.b) << ", "
+                   << blockName(function, instruction.c);
+                break;
+            case Opcode::Return:
+                os << "return %" << instruction.a;
+                break;
+        }
+        os << std::endl;
+    }
+    for (auto &loop : function.loops)
+    {
+        if (loop.counter != None)
+        {
+            os << "; loop at %" << loop.bodyBegin << " counts %" << loop.counter << " over [" << loop.first << ", "
+               << loop.last << "]" << std::endl;
+        }
+    }
+}
+
+}
+
+size_t Module::bytes() const
+{
+    size_t bytes = sizeof(Module) + functions.capacity() * sizeof(Function) +
+                   variables.capacity() * sizeof(Variable) + dimensions.capacity() * sizeof(uint64_t) +
+                   doubles.capacity() * sizeof(double) + strings.capacity() * sizeof(std::string);
+    for (auto &function : functions)
+    {
+        bytes += function.instructions.capacity() * sizeof(Instruction) +
+                 function.locations.capacity() * sizeof(Location) + function.operands.capacity() * sizeof(uint32_t) +
+                 function.blocks.capacity() * sizeof(BlockKind) + function.loops.capacity() * sizeof(Loop) +
+                 function.parameterTypes.capacity() * sizeof(llvm::Type *);
+    }
+    return bytes;
+}
+
+bool lowerProgram(AST_Block &programBlock, CodeGenContext &context, bool boundsChecks, Module &module,
+                  std::string &reason)
+{
+    Lowering lowering(context, boundsChecks, module);
+    if (!lowering.lowerProgram(programBlock))
+    {
+        reason = lowering.reason;
+        return false;
+    }
+    return true;
+}
+
+void printModule(const Module &module, std::ostream &os)
+{
+    for (auto &variable : module.variables)
+    {
+        if (variable.kind != VariableKind::Global)
+        {
+            continue;
+        }
+        os << "global " << typeName(variable.type) << " " << variable.name;
+        for (uint32_t i = 0; i < variable.dimensions; i++)
+        {
+            os << "[" << module.dimensions[variable.firstDimension + i] << "]";
+        }
+        os << std::endl;
+    }
+    for (auto &function : module.functions)
+    {
+        os << std::endl;
+        printFunction(module, function, os);
+    }
+}
+
+}
@@ -0,0 +1,267 @@
+#ifndef SLANG_MIR_H
+#define SLANG_MIR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <llvm/IR/Type.h>
+#include "absyn.h"
+
+class CodeGenContext;
+
+/*
+ * The Slang mid-level IR: a program after the semantic analysis, lowered to
+ * flat instruction arrays that LLVM IR is emitted from in one sweep.
+ *
+ * Values are instruction indices into the function that computes them, an
+ * instruction only uses values computed before it. Variables live in memory,
+ * Local and Global yield their address and Load/Store access it, the way
+ * IR generation from the AST does; LLVM's mem2reg makes SSA of them. Blocks
+ * begin at a Label and end at a Branch, CondBranch or Return.
+ *
+ *     int f(int a) { return a + 1; }
+ *
+ *     %0 = label entry
+ *     %1 = local a
+ *     %2 = argument 0
+ *          store %1, %2
+ *     %4 = load int %1
+ *     %5 = int 1
+ *     %6 = add int %4, %5
+ *          return %6
+ */
+namespace mir
+{
+
+// No value, no variable.
+const uint32_t None = UINT32_MAX;
+
+enum class Opcode : uint8_t
+{
+    Nop,            // removed by a pass
+    Label,          // c: the block that begins here
+    ConstInt,       // c: the value
+    ConstDouble,    // c: index into Module::doubles
+    ConstString,    // c: index into Module::strings, a pointer to the characters
+    Argument,       // c: the parameter
+    Local,          // c: the variable; the address of its stack slot
+    Global,         // c: the variable; its address
+    Load,           // a: address
+    Store,          // a: address, b: value
+    ElementAddress, // a: address of the array, b: element index, c: the array variable
+    MemberAddress,  // a: address of the struct, b: member index, c: the struct variable
+    CheckIndex,     // a: index, c: bound; traps unless 0 <= a < c
+    Binary,         // op: BinaryOp, a, b
+    Convert,        // op: ConvertOp, a: value
+    ToBool,         // a: value; the test of if and for, the low bit of an integer
+    Call,           // a: first argument in Function::operands, b: arguments, c: the callee
+    Branch,         // c: target block
+    CondBranch,     // a: condition, b: block if true, c: block if false
+    Return          // a: value
+};
+
+enum class ValueType : uint8_t
+{
+    None,
+    Bool,
+    Char,
+    Int,
+    Float,
+    Double,
+    String,
+    Address
+};
+
+enum class BinaryOp : uint8_t
+{
+    Add,
+    Sub,
+    Mul,
+    Div,
+    And,
+    Or,
+    Xor,
+    Shl,
+    Shr,
+    Lt,
+    Le,
+    Ge,
+    Gt,
+    Eq,
+    Ne
+};
+
+enum class ConvertOp : uint8_t
+{
+    SIToFP,
+    UIToFP,
+    FPToSI,
+    FPExt
+};
+
+struct Instruction
+{
+    Opcode opcode;
+    // Type of the result, of the operands for a comparison.
+    ValueType type;
+    // BinaryOp or ConvertOp.
+    uint8_t op;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+};
+
+/*
+ * resultType: the type of the value an instruction computes, Bool for a comparison.
+ */
+inline ValueType resultType(const Instruction &instruction)
+{
+    return instruction.opcode == Opcode::Binary && instruction.op >= (uint8_t) BinaryOp::Lt ? ValueType::Bool
+                                                                                           : instruction.type;
+}
+
+struct Location
+{
+    int row;
+    int col;
+};
+
+enum class VariableKind : uint8_t
+{
+    Local,
+    Global,
+    Parameter
+};
+
+struct Variable
+{
+    std::string name;
+    VariableKind kind;
+    // Of a scalar, None for a struct or an array.
+    ValueType valueType;
+    // Scalar or struct type, the element type of an array.
+    llvm::Type *type;
+    // Dimensions of an array in Module::dimensions, none for a scalar.
+    uint32_t firstDimension;
+    uint32_t dimensions;
+    // Elements of an array, 1 for a scalar.
+    uint64_t elements;
+};
+
+enum class BlockKind : uint8_t
+{
+    Entry,
+    Then,
+    Else,
+    IfEnd,
+    Loop,
+    LoopEnd
+};
+
+/*
+ * Loop: a for, while or do loop. The instructions from bodyBegin, the Label
+ * of the body, to bodyEnd are its body, the increment and the test that loops
+ * back follow up to the CondBranch at latch.
+ */
+struct Loop
+{
+    uint32_t initialBegin;
+    uint32_t bodyBegin;
+    uint32_t bodyEnd;
+    uint32_t latch;
+    bool atLeastOnce;
+
+    // Set by analyzeLoops() if the loop counts a local up by one from a
+    // constant to a constant: the Local, and the values it has in the body.
+    uint32_t counter = None;
+    int64_t first = 0;
+    int64_t last = 0;
+};
+
+struct Function
+{
+    std::string name;
+    Location location;
+    bool isExternal;
+    // The function whose llvm::Function this one defines: a prototype before it, or itself.
+    uint32_t target;
+    llvm::Type *returnType;
+    // Array parameters are pointers to the element type.
+    std::vector<llvm::Type *> parameterTypes;
+    std::vector<std::string> parameterNames;
+
+    std::vector<Instruction> instructions;
+    std::vector<Location> locations;
+    // Arguments of the calls.
+    std::vector<uint32_t> operands;
+    std::vector<BlockKind> blocks;
+    std::vector<Loop> loops;
+};
+
+struct Module
+{
+    // In program order, prototypes included.
+    std::vector<Function> functions;
+    std::vector<Variable> variables;
+    std::vector<uint64_t> dimensions;
+    std::vector<double> doubles;
+    std::vector<std::string> strings;
+
+    /*
+     * bytes: the memory held by the instruction and variable arrays.
+     */
+    size_t bytes() const;
+};
+
+struct Statistics
+{
+    size_t instructions = 0;
+    unsigned loops = 0;
+    unsigned countedLoops = 0;
+    unsigned boundsChecks = 0;
+    unsigned boundsChecksRemoved = 0;
+    unsigned inlinedCalls = 0;
+};
+
+/*
+ * lowerProgram: lower the AST, fresh from analyzeProgram(), to module. Only what IR generation
+ * from the AST compiles without an error is lowered, anything else returns
+ * false with the reason, for IR generation from the AST to compile and report.
+ * @param boundsChecks -- check every array index against its dimension.
+ */
+bool lowerProgram(AST_Block &programBlock, CodeGenContext &context, bool boundsChecks, Module &module,
+                  std::string &reason);
+
+/*
+ * inlineCalls: replace the calls of tiny helpers, straight-line functions of a
+ * few instructions with no calls and no arrays, by their body.
+ */
+void inlineCalls(Module &module, Statistics &statistics);
+
+/*
+ * analyzeLoops: find the counted loops, `for (i = c0; i < c1; i++)` and its
+ * <= form, whose body does not assign i.
+ */
+void analyzeLoops(Module &module, Statistics &statistics);
+
+/*
+ * removeBoundsChecks: drop the checks of indices that are in range: constants,
+ * and counters of analyzed loops plus or minus a constant.
+ */
+void removeBoundsChecks(Module &module, Statistics &statistics);
+
+/*
+ * emitModule: generate the LLVM IR of module into context.theModule.
+ */
+void emitModule(const Module &module, CodeGenContext &context);
+
+/*
+ * printModule: the text form of module for -dump-mir.
+ */
+void printModule(const Module &module, std::ostream &os);
+
+}
+
+#endif //SLANG_MIR_H
@@ -0,0 +1,331 @@
+#include <llvm/IR/Intrinsics.h>
+#include "IR.h"
+#include "mir.h"
+#include "time_report.h"
+
+namespace mir
+{
+
+namespace
+{
+
+// The names IR generation from the AST gives the blocks, for comparable output.
+const char *const BlockNames[] = {"entry", "then", "else", "ifcont", "forloop", "forcont"};
+
+/*
+ * Emitter: LLVM IR in one pass over the instructions of each function. The
+ * values of a function are kept in an array indexed like its instructions.
+ */
+class Emitter
+{
+public:
+    Emitter(const Module &module, CodeGenContext &context) :
+            module(module), context(context), builder(context.builder), types(context.typeSystem)
+    {}
+
+    void emitModule()
+    {
+        globals.resize(module.variables.size(), nullptr);
+        for (size_t i = 0; i < module.variables.size(); i++)
+        {
+            const Variable &variable = module.variables[i];
+            if (variable.kind != VariableKind::Global)
+            {
+                continue;
+            }
+            if (variable.dimensions)
+            {
+                llvm::ArrayType *arrayType = llvm::ArrayType::get(variable.type, variable.elements);
+                globals[i] = new GlobalVariable(*context.theModule, arrayType, false, GlobalValue::ExternalLinkage,
+                                                ConstantAggregateZero::get(arrayType), "arraytmp");
+            } else
+            {
+                globals[i] = new GlobalVariable(*context.theModule, variable.type, false,
+                                                GlobalValue::ExternalLinkage, context.getInitial(variable.type));
+            }
+        }
+
+        // Declare all functions first, calls may go to a function defined further down.
+        functions.resize(module.functions.size(), nullptr);
+        for (size_t i = 0; i < module.functions.size(); i++)
+        {
+            const Function &function = module.functions[i];
+            if (function.target != i)
+            {
+                functions[i] = functions[function.target];
+                continue;
+            }
+            auto functionType = FunctionType::get(function.returnType, function.parameterTypes, false);
+            functions[i] = llvm::Function::Create(functionType, GlobalValue::ExternalLinkage, function.name,
+                                                  context.theModule.get());
+        }
+        for (size_t i = 0; i < module.functions.size(); i++)
+        {
+            if (!module.functions[i].isExternal)
+            {
+                emitFunction(module.functions[i], functions[i]);
+            }
+        }
+    }
+
+private:
+    const Module &module;
+    CodeGenContext &context;
+    IRBuilder<> &builder;
+    const TypeSystem &types;
+    std::vector<Value *> globals;
+    std::vector<llvm::Function *> functions;
+
+    // Of the function being emitted.
+    std::vector<Value *> values;
+    std::vector<BasicBlock *> blocks;
+    std::vector<Value *> arguments;
+    BasicBlock *boundsFail = nullptr;
+
+    llvm::Type *typeOf(ValueType type) const
+    {
+        switch (type)
+        {
+            case ValueType::Bool:
+                return types.boolTy;
+            case ValueType::Char:
+                return types.charTy;
+            case ValueType::Int:
+                return types.intTy;
+            case ValueType::Float:
+                return types.floatTy;
+            case ValueType::Double:
+                return types.doubleTy;
+            case ValueType::String:
+                return types.stringTy;
+            default:
+                return types.voidTy;
+        }
+    }
+
+    llvm::Type *allocatedType(const Variable &variable) const
+    {
+        if (variable.dimensions)
+        {
+            return llvm::ArrayType::get(variable.type, variable.elements);
+        }
+        return variable.valueType == ValueType::Address ? PointerType::get(variable.type, 0) : variable.type;
+    }
+
+    void emitFunction(const Function &function, llvm::Function *llvmFunction)
+    {
+        TimeRegion region("IR generation", function.name);
+        const std::vector<Instruction> &instructions = function.instructions;
+        values.assign(instructions.size(), nullptr);
+        blocks.clear();
+        for (auto kind : function.blocks)
+        {
+            blocks.push_back(BasicBlock::Create(context.llvmContext, BlockNames[(int) kind]));
+        }
+        arguments.clear();
+        auto name = function.parameterNames.begin();
+        for (auto &argument : llvmFunction->args())
+        {
+            argument.setName(*name++);
+            arguments.push_back(&argument);
+        }
+        boundsFail = nullptr;
+
+        blocks[0]->insertInto(llvmFunction);
+        builder.SetInsertPoint(blocks[0]);
+        context.enterFunctionScope(llvmFunction, function.location.row, function.location.col);
+        // Every variable gets its stack slot in the entry block, where mem2reg looks for them.
+        for (size_t i = 0; i < instructions.size(); i++)
+        {
+            if (instructions[i].opcode == Opcode::Local)
+            {
+                const Variable &variable = module.variables[instructions[i].c];
+                values[i] = builder.CreateAlloca(allocatedType(variable), nullptr,
+                                                 variable.dimensions ? "arraytmp" : "");
+            }
+        }
+
+        Location location = function.location;
+        for (size_t i = 0; i < instructions.size(); i++)
+        {
+            if (function.locations[i].row != location.row || function.locations[i].col != location.col)
+            {
+                location = function.locations[i];
+                context.emitLocation(location.row, location.col);
+            }
+            values[i] = emitInstruction(function, instructions[i], llvmFunction, values[i]);
+        }
+        if (boundsFail)
+        {
+            boundsFail->insertInto(llvmFunction);
+        }
+        context.leaveFunctionScope();
+    }
+
+    Value *emitInstruction(const Function &function, const Instruction &instruction, llvm::Function *llvmFunction,
+                           Value *value)
+    {
+        switch (instruction.opcode)
+        {
+            case Opcode::Nop:
+                return nullptr;
+            case Opcode::Label:
+                if (instruction.c != 0)
+                {
+                    blocks[instruction.c]->insertInto(llvmFunction);
+                    builder.SetInsertPoint(blocks[instruction.c]);
+                }
+                return nullptr;
+            case Opcode::ConstInt:
+                return ConstantInt::get(types.intTy, instruction.c, true);
+            case Opcode::ConstDouble:
+                return ConstantFP::get(types.doubleTy, module.doubles[instruction.c]);
+            case Opcode::ConstString:
+                return builder.CreateGlobalStringPtr(module.strings[instruction.c], "string");
+            case Opcode::Argument:
+                return arguments[instruction.c];
+            case Opcode::Local:
+                // Allocated in the entry block.
+                return value;
+            case Opcode::Global:
+                return globals[instruction.c];
+            case Opcode::Load:
+                return builder.CreateLoad(typeOf(instruction.type), values[instruction.a]);
+            case Opcode::Store:
+                return builder.CreateStore(values[instruction.b], values[instruction.a]);
+            case Opcode::ElementAddress:
+            {
+                const Variable &variable = module.variables[instruction.c];
+                Value *indices[] = {ConstantInt::get(Type::getInt64Ty(context.llvmContext), 0),
+                                    values[instruction.b]};
+                return builder.CreateInBoundsGEP(allocatedType(variable), values[instruction.a], indices,
+                                                 "elementPtr");
+            }
+            case Opcode::MemberAddress:
+            {
+                const Variable &variable = module.variables[instruction.c];
+                Value *indices[] = {ConstantInt::get(types.intTy, 0, false),
+                                    ConstantInt::get(types.intTy, instruction.b, false)};
+                return builder.CreateInBoundsGEP(variable.type, values[instruction.a], indices, "memberPtr");
+            }
+            case Opcode::CheckIndex:
+                emitCheck(values[instruction.a], instruction.c, llvmFunction);
+                return nullptr;
+            case Opcode::Binary:
+                return emitBinary(instruction);
+            case Opcode::Convert:
+                switch ((ConvertOp) instruction.op)
+                {
+                    case ConvertOp::SIToFP:
+                        return builder.CreateSIToFP(values[instruction.a], typeOf(instruction.type), "cast");
+                    case ConvertOp::UIToFP:
+                        return builder.CreateUIToFP(values[instruction.a], typeOf(instruction.type), "ftmp");
+                    case ConvertOp::FPToSI:
+                        return builder.CreateFPToSI(values[instruction.a], typeOf(instruction.type), "cast");
+                    case ConvertOp::FPExt:
+                        return builder.CreateFPExt(values[instruction.a], typeOf(instruction.type), "cast");
+                }
+                return nullptr;
+            case Opcode::ToBool:
+            {
+                // CastToBoolean.
+                Value *condition = values[instruction.a];
+                if (condition->getType()->isDoubleTy())
+                {
+                    return builder.CreateFCmpONE(condition, ConstantFP::get(types.doubleTy, 0.0));
+                }
+                condition = builder.CreateIntCast(condition, types.boolTy, true);
+                return builder.CreateICmpNE(condition, ConstantInt::get(types.boolTy, 0, true));
+            }
+            case Opcode::Call:
+            {
+                std::vector<Value *> callArguments;
+                for (uint32_t i = 0; i < instruction.b; i++)
+                {
+                    callArguments.push_back(values[function.operands[instruction.a + i]]);
+                }
+                // A void value has no name.
+                return builder.CreateCall(functions[instruction.c], callArguments,
+                                          instruction.type == ValueType::None ? "" : "calltmp");
+            }
+            case Opcode::Branch:
+                return builder.CreateBr(blocks[instruction.c]);
+            case Opcode::CondBranch:
+                return builder.CreateCondBr(values[instruction.a], blocks[instruction.b], blocks[instruction.c]);
+            case Opcode::Return:
+                return builder.CreateRet(values[instruction.a]);
+        }
+        return nullptr;
+    }
+
+    Value *emitBinary(const Instruction &instruction)
+    {
+        Value *L = values[instruction.a];
+        Value *R = values[instruction.b];
+        bool fp = instruction.type == ValueType::Double;
+        switch ((BinaryOp) instruction.op)
+        {
+            case BinaryOp::Add:
+                return fp ? builder.CreateFAdd(L, R, "addftmp") : builder.CreateAdd(L, R, "addtmp");
+            case BinaryOp::Sub:
+                return fp ? builder.CreateFSub(L, R, "subftmp") : builder.CreateSub(L, R, "subtmp");
+            case BinaryOp::Mul:
+                return fp ? builder.CreateFMul(L, R, "mulftmp") : builder.CreateMul(L, R, "multmp");
+            case BinaryOp::Div:
+                return fp ? builder.CreateFDiv(L, R, "divftmp") : builder.CreateSDiv(L, R, "divtmp");
+            case BinaryOp::And:
+                return builder.CreateAnd(L, R, "andtmp");
+            case BinaryOp::Or:
+                return builder.CreateOr(L, R, "ortmp");
+            case BinaryOp::Xor:
+                return builder.CreateXor(L, R, "xortmp");
+            case BinaryOp::Shl:
+                return builder.CreateShl(L, R, "shltmp");
+            case BinaryOp::Shr:
+                return builder.CreateAShr(L, R, "ashrtmp");
+            case BinaryOp::Lt:
+                return fp ? builder.CreateFCmpULT(L, R, "cmpftmp") : builder.CreateICmpULT(L, R, "cmptmp");
+            case BinaryOp::Le:
+                return fp ? builder.CreateFCmpOLE(L, R, "cmpftmp") : builder.CreateICmpSLE(L, R, "cmptmp");
+            case BinaryOp::Ge:
+                return fp ? builder.CreateFCmpOGE(L, R, "cmpftmp") : builder.CreateICmpSGE(L, R, "cmptmp");
+            case BinaryOp::Gt:
+                return fp ? builder.CreateFCmpOGT(L, R, "cmpftmp") : builder.CreateICmpSGT(L, R, "cmptmp");
+            case BinaryOp::Eq:
+                return fp ? builder.CreateFCmpOEQ(L, R, "cmpftmp") : builder.CreateICmpEQ(L, R, "cmptmp");
+            case BinaryOp::Ne:
+                return fp ? builder.CreateFCmpONE(L, R, "cmpftmp") : builder.CreateICmpNE(L, R, "cmptmp");
+        }
+        return nullptr;
+    }
+
+    /*
+     * emitCheck: branch to a trap unless 0 <= index < bound, and go on in a new block.
+     */
+    void emitCheck(Value *index, uint32_t bound, llvm::Function *llvmFunction)
+    {
+        if (!boundsFail)
+        {
+            // Shared by the checks of the function, inserted at its end.
+            boundsFail = BasicBlock::Create(context.llvmContext, "boundsfail");
+            IRBuilder<> failBuilder(boundsFail);
+            failBuilder.SetCurrentDebugLocation(builder.getCurrentDebugLocation());
+            failBuilder.CreateCall(Intrinsic::getDeclaration(context.theModule.get(), Intrinsic::trap), {});
+            failBuilder.CreateUnreachable();
+        }
+        BasicBlock *inBounds = BasicBlock::Create(context.llvmContext, "boundsok", llvmFunction);
+        Value *outOfBounds = builder.CreateICmpUGE(index, ConstantInt::get(types.intTy, bound, false), "boundscmp");
+        builder.CreateCondBr(outOfBounds, boundsFail, inBounds);
+        builder.SetInsertPoint(inBounds);
+    }
+};
+
+}
+
+void emitModule(const Module &module, CodeGenContext &context)
+{
+    Emitter emitter(module, context);
+    emitter.emitModule();
+}
+
+}
@@ -0,0 +1,501 @@
+#include <climits>
+#include "mir.h"
+
+namespace mir
+{
+
+namespace
+{
+
+// Callees up to this many instructions are inlined.
+const size_t InlineLimit = 24;
+
+/*
+ * forEachOperand: call visit(uint32_t &) on every value instruction uses,
+ * the arguments of a call are in function.operands.
+ */
+template<typename Visit>
+void forEachOperand(Instruction &instruction, std::vector<uint32_t> &operands, Visit &&visit)
+{
+    switch (instruction.opcode)
+    {
+        case Opcode::Load:
+        case Opcode::MemberAddress:
+        case Opcode::CheckIndex:
+        case Opcode::Convert:
+        case Opcode::ToBool:
+        case Opcode::CondBranch:
+        case Opcode::Return:
+            visit(instruction.a);
+            break;
+        case Opcode::Store:
+        case Opcode::ElementAddress:
+        case Opcode::Binary:
+            visit(instruction.a);
+            visit(instruction.b);
+            break;
+        case Opcode::Call:
+            for (uint32_t i = 0; i < instruction.b; i++)
+            {
+                visit(operands[instruction.a + i]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * definitionOf: the function that defines what a call to callee runs, None if it is external.
+ */
+uint32_t definitionOf(const Module &module, uint32_t callee)
+{
+    if (!module.functions[callee].isExternal)
+    {
+        return callee;
+    }
+    for (uint32_t i = callee + 1; i < module.functions.size(); i++)
+    {
+        const Function &function = module.functions[i];
+        if (!function.isExternal && function.target == callee)
+        {
+            return i;
+        }
+    }
+    return None;
+}
+
+/*
+ * isInlinable: one block, a few instructions, no calls, and only scalar locals.
+ */
+bool isInlinable(const Module &module, const Function &function)
+{
+    if (function.isExternal || function.blocks.size() != 1 || function.instructions.size() > InlineLimit)
+    {
+        return false;
+    }
+    for (auto &instruction : function.instructions)
+    {
+        if (instruction.opcode == Opcode::Call)
+        {
+            return false;
+        }
+        if (instruction.opcode == Opcode::Local)
+        {
+            const Variable &variable = module.variables[instruction.c];
+            if (variable.valueType == ValueType::None || variable.valueType == ValueType::Address)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Inliner: rebuilds the instructions of a function with the calls of
+ * inlinable callees replaced by their bodies.
+ */
+class Inliner
+{
+public:
+    Inliner(Module &module, const std::vector<bool> &inlinable) : module(module), inlinable(inlinable)
+    {}
+
+    unsigned inlineCalls(Function &caller)
+    {
+        unsigned inlined = 0;
+        for (auto &instruction : caller.instructions)
+        {
+            if (instruction.opcode == Opcode::Call && inlinable[instruction.c])
+            {
+                inlined++;
+            }
+        }
+        if (inlined == 0)
+        {
+            return 0;
+        }
+
+        size_t count = caller.instructions.size();
+        // Where each instruction went: its value, and the first instruction emitted for it.
+        std::vector<uint32_t> values(count, None);
+        std::vector<uint32_t> positions(count + 1, None);
+        std::vector<uint32_t> operands;
+        for (size_t i = 0; i < count; i++)
+        {
+            positions[i] = (uint32_t) instructions.size();
+            Instruction instruction = caller.instructions[i];
+            Location location = caller.locations[i];
+            if (instruction.opcode == Opcode::Call && inlinable[instruction.c])
+            {
+                std::vector<uint32_t> arguments(caller.operands.begin() + instruction.a,
+                                                caller.operands.begin() + instruction.a + instruction.b);
+                for (auto &argument : arguments)
+                {
+                    argument = values[argument];
+                }
+                values[i] = inlineBody(module.functions[definitionOf(module, instruction.c)], arguments, location);
+                continue;
+            }
+            if (instruction.opcode == Opcode::Call)
+            {
+                uint32_t first = (uint32_t) operands.size();
+                for (uint32_t j = 0; j < instruction.b; j++)
+                {
+                    operands.push_back(values[caller.operands[instruction.a + j]]);
+                }
+                instruction.a = first;
+            } else
+            {
+                forEachOperand(instruction, operands, [&values](uint32_t &value)
+                {
+                    value = values[value];
+                });
+            }
+            values[i] = append(instruction, location);
+        }
+        positions[count] = (uint32_t) instructions.size();
+
+        for (auto &loop : caller.loops)
+        {
+            loop.initialBegin = positions[loop.initialBegin];
+            loop.bodyBegin = positions[loop.bodyBegin];
+            loop.bodyEnd = positions[loop.bodyEnd];
+            loop.latch = positions[loop.latch];
+        }
+        caller.instructions.swap(instructions);
+        caller.locations.swap(locations);
+        caller.operands.swap(operands);
+        instructions.clear();
+        locations.clear();
+        return inlined;
+    }
+
+private:
+    Module &module;
+    const std::vector<bool> &inlinable;
+    std::vector<Instruction> instructions;
+    std::vector<Location> locations;
+
+    uint32_t append(const Instruction &instruction, Location location)
+    {
+        instructions.push_back(instruction);
+        locations.push_back(location);
+        return (uint32_t) instructions.size() - 1;
+    }
+
+    /*
+     * inlineBody: append the body of callee, located at the call, and return its return value.
+     * A local stored once before it is loaded, a parameter typically, is replaced by the value stored.
+     */
+    uint32_t inlineBody(const Function &callee, const std::vector<uint32_t> &arguments, Location location)
+    {
+        size_t count = callee.instructions.size();
+        std::vector<unsigned> stores(count, 0);
+        std::vector<bool> loadedBeforeStore(count, false);
+        for (auto &instruction : callee.instructions)
+        {
+            if (instruction.opcode == Opcode::Store && callee.instructions[instruction.a].opcode == Opcode::Local)
+            {
+                stores[instruction.a]++;
+            } else if (instruction.opcode == Opcode::Load &&
+                       callee.instructions[instruction.a].opcode == Opcode::Local && stores[instruction.a] == 0)
+            {
+                loadedBeforeStore[instruction.a] = true;
+            }
+        }
+        auto forwarded = [&](uint32_t local)
+        {
+            return callee.instructions[local].opcode == Opcode::Local && stores[local] == 1 &&
+                   !loadedBeforeStore[local];
+        };
+
+        std::vector<uint32_t> values(count, None);
+        // The value last stored to a forwarded local.
+        std::vector<uint32_t> stored(count, None);
+        uint32_t returnValue = None;
+        std::vector<uint32_t> unusedOperands;
+        for (size_t i = 0; i < count; i++)
+        {
+            Instruction instruction = callee.instructions[i];
+            switch (instruction.opcode)
+            {
+                case Opcode::Label:
+                case Opcode::Nop:
+                    continue;
+                case Opcode::Argument:
+                    values[i] = arguments[instruction.c];
+                    continue;
+                case Opcode::Return:
+                    returnValue = values[instruction.a];
+                    continue;
+                case Opcode::Local:
+                    if (forwarded((uint32_t) i))
+                    {
+                        continue;
+                    }
+                    break;
+                case Opcode::Store:
+                    if (forwarded(instruction.a))
+                    {
+                        stored[instruction.a] = values[instruction.b];
+                        continue;
+                    }
+                    break;
+                case Opcode::Load:
+                    if (forwarded(instruction.a))
+                    {
+                        values[i] = stored[instruction.a];
+                        continue;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            forEachOperand(instruction, unusedOperands, [&values](uint32_t &value)
+            {
+                value = values[value];
+            });
+            values[i] = append(instruction, location);
+        }
+        return returnValue;
+    }
+};
+
+/*
+ * localOf: the Local a value loads from, None if it is not such a load.
+ */
+uint32_t localOf(const Function &function, uint32_t value)
+{
+    const Instruction &load = function.instructions[value];
+    if (load.opcode != Opcode::Load || load.type != ValueType::Int ||
+        function.instructions[load.a].opcode != Opcode::Local)
+    {
+        return None;
+    }
+    return load.a;
+}
+
+bool isConstant(const Function &function, uint32_t value, int64_t &constant)
+{
+    const Instruction &instruction = function.instructions[value];
+    if (instruction.opcode != Opcode::ConstInt)
+    {
+        return false;
+    }
+    constant = (int32_t) instruction.c;
+    return true;
+}
+
+/*
+ * isIncrement: whether value is local + 1, or 1 + local.
+ */
+bool isIncrement(const Function &function, uint32_t value, uint32_t local)
+{
+    const Instruction &add = function.instructions[value];
+    if (add.opcode != Opcode::Binary || add.op != (uint8_t) BinaryOp::Add || add.type != ValueType::Int)
+    {
+        return false;
+    }
+    int64_t one;
+    return (localOf(function, add.a) == local && isConstant(function, add.b, one) && one == 1) ||
+           (localOf(function, add.b) == local && isConstant(function, add.a, one) && one == 1);
+}
+
+/*
+ * analyzeLoop: fill in the counter of loop if it has one. The test of the
+ * loop is `counter < n` or `counter <= n`, the initial statement stores a
+ * constant to it, the increment adds one to it and the body leaves it alone.
+ */
+bool analyzeLoop(Function &function, Loop &loop)
+{
+    const std::vector<Instruction> &instructions = function.instructions;
+    const Instruction &latch = instructions[loop.latch];
+    const Instruction &test = instructions[latch.a];
+    if (test.opcode != Opcode::ToBool)
+    {
+        return false;
+    }
+    const Instruction &compare = instructions[test.a];
+    if (compare.opcode != Opcode::Binary || compare.type != ValueType::Int ||
+        (compare.op != (uint8_t) BinaryOp::Lt && compare.op != (uint8_t) BinaryOp::Le))
+    {
+        return false;
+    }
+    uint32_t counter = localOf(function, compare.a);
+    int64_t bound;
+    if (counter == None || !isConstant(function, compare.b, bound))
+    {
+        return false;
+    }
+
+    // The last store of the initial statement.
+    int64_t first = 0;
+    bool initialized = false;
+    for (uint32_t i = loop.initialBegin; i < loop.bodyBegin; i++)
+    {
+        if (instructions[i].opcode == Opcode::Store && instructions[i].a == counter)
+        {
+            initialized = isConstant(function, instructions[i].b, first);
+        }
+    }
+    if (!initialized)
+    {
+        return false;
+    }
+    for (uint32_t i = loop.bodyBegin; i < loop.bodyEnd; i++)
+    {
+        if (instructions[i].opcode == Opcode::Store && instructions[i].a == counter)
+        {
+            return false;
+        }
+    }
+    unsigned increments = 0;
+    for (uint32_t i = loop.bodyEnd; i < loop.latch; i++)
+    {
+        if (instructions[i].opcode == Opcode::Store && instructions[i].a == counter)
+        {
+            if (!isIncrement(function, instructions[i].b, counter))
+            {
+                return false;
+            }
+            increments++;
+        }
+    }
+    if (increments != 1)
+    {
+        return false;
+    }
+
+    int64_t last;
+    if (compare.op == (uint8_t) BinaryOp::Lt)
+    {
+        // The comparison is unsigned, it agrees with the signed one on non-negative values.
+        if (first < 0 || bound < 0)
+        {
+            return false;
+        }
+        last = bound - 1;
+    } else
+    {
+        // counter <= INT_MAX never fails.
+        if (bound == INT32_MAX)
+        {
+            return false;
+        }
+        last = bound;
+    }
+    loop.counter = counter;
+    loop.first = first;
+    // A loop that is never entered runs its body with no value at all, a do loop with the first.
+    loop.last = last < first ? first : last;
+    return true;
+}
+
+}
+
+void inlineCalls(Module &module, Statistics &statistics)
+{
+    std::vector<bool> inlinable(module.functions.size(), false);
+    for (uint32_t i = 0; i < module.functions.size(); i++)
+    {
+        // Calls name the first declaration of a function.
+        uint32_t definition = definitionOf(module, i);
+        inlinable[i] = definition != None && isInlinable(module, module.functions[definition]);
+    }
+    Inliner inliner(module, inlinable);
+    for (auto &function : module.functions)
+    {
+        if (!function.isExternal)
+        {
+            statistics.inlinedCalls += inliner.inlineCalls(function);
+        }
+    }
+}
+
+void analyzeLoops(Module &module, Statistics &statistics)
+{
+    for (auto &function : module.functions)
+    {
+        for (auto &loop : function.loops)
+        {
+            statistics.loops++;
+            statistics.countedLoops += analyzeLoop(function, loop);
+        }
+    }
+}
+
+void removeBoundsChecks(Module &module, Statistics &statistics)
+{
+    for (auto &function : module.functions)
+    {
+        for (uint32_t i = 0; i < function.instructions.size(); i++)
+        {
+            Instruction &check = function.instructions[i];
+            if (check.opcode != Opcode::CheckIndex)
+            {
+                continue;
+            }
+            statistics.boundsChecks++;
+
+            // The index as counter + offset, or a constant.
+            int64_t offset = 0;
+            uint32_t counter = localOf(function, check.a);
+            uint32_t load = check.a;
+            const Instruction &index = function.instructions[check.a];
+            if (counter == None && index.opcode == Opcode::Binary && index.type == ValueType::Int &&
+                (index.op == (uint8_t) BinaryOp::Add || index.op == (uint8_t) BinaryOp::Sub))
+            {
+                load = index.a;
+                counter = localOf(function, index.a);
+                if (counter != None && isConstant(function, index.b, offset))
+                {
+                    offset = index.op == (uint8_t) BinaryOp::Sub ? -offset : offset;
+                } else if (index.op == (uint8_t) BinaryOp::Add && isConstant(function, index.a, offset))
+                {
+                    load = index.b;
+                    counter = localOf(function, index.b);
+                } else
+                {
+                    counter = None;
+                }
+            }
+
+            int64_t low, high;
+            if (isConstant(function, check.a, low))
+            {
+                high = low;
+            } else if (counter != None)
+            {
+                const Loop *counted = nullptr;
+                for (auto &loop : function.loops)
+                {
+                    if (loop.counter == counter && loop.bodyBegin <= load && load < loop.bodyEnd &&
+                        loop.bodyBegin <= i && i < loop.bodyEnd)
+                    {
+                        counted = &loop;
+                        break;
+                    }
+                }
+                if (!counted)
+                {
+                    continue;
+                }
+                low = counted->first + offset;
+                high = counted->last + offset;
+            } else
+            {
+                continue;
+            }
+            // In range, and computed without wrapping around.
+            if (low >= 0 && high < (int64_t) check.c && high <= INT32_MAX)
+            {
+                check.opcode = Opcode::Nop;
+                statistics.boundsChecksRemoved++;
+            }
+        }
+    }
+}
+
+}
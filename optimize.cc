@@ -1,24 +1,105 @@
+#include <cstdlib>
+#include <set>
 #include <llvm/Analysis/Passes.h>
 #include <llvm/Analysis/LoopPass.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Linker/Linker.h>
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/PluginLoader.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO.h>
+#include <llvm/Transforms/Instrumentation.h>
 #include <llvm/Transforms/Scalar.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Vectorize.h>
+#include "diagnostics.h"
 #include "optimize.h"
+#include "time_report.h"
+
+/*
+ * Functions per partition in parallel mode. Partitions are cut in module
+ * order and do not depend on the thread count, so the output is the same
+ * for every -j value.
+ */
+static const unsigned FunctionsPerPartition = 8;
+
+int parseOptimizationLevel(const std::string &flag)
+{
+    return atoi(&flag.back());
+}
+
+void Optimizer::addTargetAnalysisPasses(llvm::legacy::PassManager &PM, llvm::TargetMachine *Target)
+{
+    // Let inlining, unrolling and vectorization query the real target.
+    if (Target)
+    {
+        PM.add(new llvm::TargetLibraryInfoWrapperPass(Target->getTargetTriple()));
+        PM.add(llvm::createTargetTransformInfoWrapperPass(Target->getTargetIRAnalysis()));
+    }
+}
+
+void Optimizer::addProfilePasses(llvm::legacy::PassManager &PM)
+{
+    if (!ProfileGenerate && ProfileUseFile.empty())
+        return;
+
+    if (OptimizationLevel > 0)
+    {
+        // Fewer blocks and no allocas means fewer counters and a more stable CFG to match profiles against.
+        addPass(PM, llvm::createCFGSimplificationPass());
+        addPass(PM, llvm::createPromoteMemoryToRegisterPass());
+    }
+
+    if (ProfileGenerate)
+    {
+        addPass(PM, llvm::createPGOInstrumentationGenLegacyPass());
+        llvm::InstrProfOptions Options;
+        if (!ProfileGenerateDir.empty())
+            Options.InstrProfileOutput = ProfileGenerateDir + "/default_%m.profraw";
+        addPass(PM, llvm::createInstrProfilingLegacyPass(Options));
+    } else
+    {
+        // Attaches branch weights and function entry counts.
+        addPass(PM, llvm::createPGOInstrumentationUseLegacyPass(ProfileUseFile));
+    }
+}
 
 void Optimizer::addStandardCompilePasses(llvm::legacy::PassManager &PM)
 {
+    addTargetAnalysisPasses(PM, TM);
+
     // Verify that input is correct.
     if (!DontVerify)
         PM.add(llvm::createVerifierPass());
+    addProfilePasses(PM);
     if (OptimizationLevel == 0)
         return;
 
+    addModulePasses(PM);
+    addIPOCleanupPasses(PM);
+    // Remove dead EH info.
+    addPass(PM, llvm::createPruneEHPass());
+    addFunctionPasses(PM);
+    // Get rid of dead prototypes.
+    addPass(PM, llvm::createStripDeadPrototypesPass());
+
+    // Make sure everything is still good.
+    if (!DontVerify)
+        addPass(PM, llvm::createVerifierPass());
+}
+
+void Optimizer::addModulePasses(llvm::legacy::PassManager &PM)
+{
     switch (OptimizationLevel)
     {
         case 3:
@@ -46,66 +127,231 @@ void Optimizer::addStandardCompilePasses(llvm::legacy::PassManager &PM)
             addPass(PM, llvm::createIPConstantPropagationPass());
             // Dead argument elimination.
             addPass(PM, llvm::createDeadArgEliminationPass());
-            // Clean up after IPCP & DAE.
-            addPass(PM, llvm::createInstructionCombiningPass());
-            // Clean up after IPCP & DAE.
-            addPass(PM, llvm::createCFGSimplificationPass());
+    }
+}
 
-            // Remove dead EH info.
-            addPass(PM, llvm::createPruneEHPass());
-            // Deduce function attrs.
-//            addPass(PM, llvm::createFunctionAttrsPass());
-            // Cleanup for scalarrepl.
-            addPass(PM, llvm::createInstructionCombiningPass());
-            // Thread jumps.
-            addPass(PM, llvm::createJumpThreadingPass());
-            // Merge & remove BBs.
-            addPass(PM, llvm::createCFGSimplificationPass());
-            // Break up aggregate allocas.
-//            addPass(PM, llvm::createScalarReplAggregatesPass());
-            // Combine silly seq's.
-            addPass(PM, llvm::createInstructionCombiningPass());
-
-            // Eliminate tail calls.
-            addPass(PM, llvm::createTailCallEliminationPass());
-            // Merge & remove BBs.
-            addPass(PM, llvm::createCFGSimplificationPass());
-            // Reassociate expressions.
-            addPass(PM, llvm::createReassociatePass());
-            addPass(PM, llvm::createLoopRotatePass());
-            // Hoist loop invariants.
-            addPass(PM, llvm::createLICMPass());
-            // Unswitch loops.
-            addPass(PM, llvm::createLoopUnswitchPass());
-            // @FIXME : Removing instcombine causes nestedloop regression.
-            addPass(PM, llvm::createInstructionCombiningPass());
-            // Canonicalize indvars.
-            addPass(PM, llvm::createIndVarSimplifyPass());
-            // Delete dead loops.
-            addPass(PM, llvm::createLoopDeletionPass());
-            // Unroll small loops.
-            addPass(PM, llvm::createLoopUnrollPass());
-            // Clean up after the unroller.
-            addPass(PM, llvm::createInstructionCombiningPass());
-
-            // Remove memcpy / form memset.
-            addPass(PM, llvm::createMemCpyOptPass());
-            // Constant prop with SCCP.
-            addPass(PM, llvm::createSCCPPass());
-
-            // Run instcombine after redundancy elimination to exploit opportunities opened up by them.
-            addPass(PM, llvm::createInstructionCombiningPass());
-            // Delete dead stores.
-            addPass(PM, llvm::createDeadStoreEliminationPass());
-            // Delete dead instructions.
-            addPass(PM, llvm::createAggressiveDCEPass());
-            // Merge & remove BBs.
-            addPass(PM, llvm::createCFGSimplificationPass());
-            // Get rid of dead prototypes.
-            addPass(PM, llvm::createStripDeadPrototypesPass());
+void Optimizer::addIPOCleanupPasses(llvm::legacy::PassManager &PM)
+{
+    // Clean up after IPCP & DAE.
+    addPass(PM, llvm::createInstructionCombiningPass());
+    // Clean up after IPCP & DAE.
+    addPass(PM, llvm::createCFGSimplificationPass());
+}
+
+void Optimizer::addFunctionPasses(llvm::legacy::PassManager &PM)
+{
+    // Deduce function attrs.
+//    addPass(PM, llvm::createFunctionAttrsPass());
+    // Cleanup for scalarrepl.
+    addPass(PM, llvm::createInstructionCombiningPass());
+    // Thread jumps.
+    addPass(PM, llvm::createJumpThreadingPass());
+    // Merge & remove BBs.
+    addPass(PM, llvm::createCFGSimplificationPass());
+    // Break up aggregate allocas.
+//    addPass(PM, llvm::createScalarReplAggregatesPass());
+    // Combine silly seq's.
+    addPass(PM, llvm::createInstructionCombiningPass());
+
+    // Eliminate tail calls.
+    addPass(PM, llvm::createTailCallEliminationPass());
+    // Merge & remove BBs.
+    addPass(PM, llvm::createCFGSimplificationPass());
+    // Reassociate expressions.
+    addPass(PM, llvm::createReassociatePass());
+    addPass(PM, llvm::createLoopRotatePass());
+    // Hoist loop invariants.
+    addPass(PM, llvm::createLICMPass());
+    // Unswitch loops.
+    addPass(PM, llvm::createLoopUnswitchPass());
+    // @FIXME : Removing instcombine causes nestedloop regression.
+    addPass(PM, llvm::createInstructionCombiningPass());
+    // Canonicalize indvars.
+    addPass(PM, llvm::createIndVarSimplifyPass());
+    // Delete dead loops.
+    addPass(PM, llvm::createLoopDeletionPass());
+    // Unroll small loops.
+    addPass(PM, llvm::createLoopUnrollPass());
+    // Clean up after the unroller.
+    addPass(PM, llvm::createInstructionCombiningPass());
+    if (OptimizationLevel > 1)
+    {
+        // Vectorize loops, the width comes from the target's TTI.
+        addPass(PM, llvm::createLoopVectorizePass());
+        // Vectorize straight-line code.
+        addPass(PM, llvm::createSLPVectorizerPass());
+        // Clean up after the vectorizers.
+        addPass(PM, llvm::createInstructionCombiningPass());
     }
 
-    // Make sure everything is still good.
+    // Remove memcpy / form memset.
+    addPass(PM, llvm::createMemCpyOptPass());
+    // Constant prop with SCCP.
+    addPass(PM, llvm::createSCCPPass());
+
+    // Run instcombine after redundancy elimination to exploit opportunities opened up by them.
+    addPass(PM, llvm::createInstructionCombiningPass());
+    // Delete dead stores.
+    addPass(PM, llvm::createDeadStoreEliminationPass());
+    // Delete dead instructions.
+    addPass(PM, llvm::createAggressiveDCEPass());
+    // Merge & remove BBs.
+    addPass(PM, llvm::createCFGSimplificationPass());
+}
+
+void Optimizer::addParallelCleanupPasses(llvm::legacy::PassManager &PM)
+{
+    // Merge constants duplicated across partitions.
+    addPass(PM, llvm::createConstantMergePass());
+    // Remove unused fns and globs.
+    addPass(PM, llvm::createGlobalDCEPass());
+    // Get rid of dead prototypes.
+    addPass(PM, llvm::createStripDeadPrototypesPass());
+}
+
+bool Optimizer::optimize(std::unique_ptr<llvm::Module> &M)
+{
+    if (Threads == 0 || OptimizationLevel == 0)
+    {
+        llvm::legacy::PassManager PM;
+        addStandardCompilePasses(PM);
+        PM.run(*M);
+        return true;
+    }
+    return optimizeInParallel(M);
+}
+
+bool Optimizer::optimizeInParallel(std::unique_ptr<llvm::Module> &M)
+{
+    llvm::LLVMContext &Context = M->getContext();
+
+    llvm::legacy::PassManager ModulePM;
+    addTargetAnalysisPasses(ModulePM, TM);
     if (!DontVerify)
-        addPass(PM, llvm::createVerifierPass());
+        ModulePM.add(llvm::createVerifierPass());
+    addProfilePasses(ModulePM);
+    addModulePasses(ModulePM);
+    // Interprocedural, so ahead of the IPCP & DAE cleanup the partitions run.
+    addPass(ModulePM, llvm::createPruneEHPass());
+    ModulePM.run(*M);
+
+    /*
+     * Cut the module into partitions. Every partition keeps all global
+     * variables so constant initializers stay visible to the function
+     * passes, but only defines its own functions.
+     */
+    std::vector<std::vector<const llvm::Function *>> Partitions;
+    for (auto &F : *M)
+    {
+        if (F.isDeclaration())
+            continue;
+        if (Partitions.empty() || Partitions.back().size() == FunctionsPerPartition)
+            Partitions.emplace_back();
+        Partitions.back().push_back(&F);
+    }
+
+    std::vector<llvm::SmallString<0>> Bitcode(Partitions.size());
+    for (size_t i = 0; i < Partitions.size(); i++)
+    {
+        std::set<const llvm::GlobalValue *> Defined(Partitions[i].begin(), Partitions[i].end());
+        llvm::ValueToValueMapTy VMap;
+        auto Partition = llvm::CloneModule(M.get(), VMap, [&](const llvm::GlobalValue *GV) {
+            return !llvm::isa<llvm::Function>(GV) || Defined.count(GV) != 0;
+        });
+        llvm::raw_svector_ostream OS(Bitcode[i]);
+        llvm::WriteBitcodeToFile(Partition.get(), OS);
+    }
+
+    // Each worker owns its LLVMContext and TargetMachine, nothing is shared.
+    std::vector<std::string> Errors(Partitions.size());
+    {
+        llvm::ThreadPool Pool(Threads);
+        for (size_t i = 0; i < Partitions.size(); i++)
+        {
+            Pool.async([this, i, &Bitcode, &Errors]() {
+                TimeRegion region("Optimization", "partition " + std::to_string(i));
+                llvm::LLVMContext WorkerContext;
+                auto Buffer = llvm::MemoryBuffer::getMemBuffer(Bitcode[i].str(), "", false);
+                auto PartitionOrErr = llvm::parseBitcodeFile(Buffer->getMemBufferRef(), WorkerContext);
+                if (!PartitionOrErr)
+                {
+                    Errors[i] = llvm::toString(PartitionOrErr.takeError());
+                    return;
+                }
+                auto Partition = std::move(*PartitionOrErr);
+
+                auto WorkerTM = TMFactory ? TMFactory() : nullptr;
+                llvm::legacy::PassManager FunctionPM;
+                addTargetAnalysisPasses(FunctionPM, WorkerTM.get());
+                addIPOCleanupPasses(FunctionPM);
+                addFunctionPasses(FunctionPM);
+                FunctionPM.run(*Partition);
+
+                /*
+                 * Only partition 0 keeps the global variable definitions,
+                 * the others refer to them. Local constants stay, the
+                 * cleanup passes merge the duplicates.
+                 */
+                if (i != 0)
+                {
+                    for (auto &GV : Partition->globals())
+                    {
+                        if (!GV.hasLocalLinkage() && GV.hasInitializer())
+                        {
+                            GV.setInitializer(nullptr);
+                            GV.setLinkage(llvm::GlobalValue::ExternalLinkage);
+                        }
+                    }
+                }
+
+                Bitcode[i].clear();
+                llvm::raw_svector_ostream OS(Bitcode[i]);
+                llvm::WriteBitcodeToFile(Partition.get(), OS);
+            });
+        }
+        Pool.wait();
+    }
+
+    for (auto &Error : Errors)
+    {
+        if (!Error.empty())
+        {
+            reportDiagnostic("slang:\033[1;31m error:\033[0m parallel optimization failed: %s\n", Error.c_str());
+            countError();
+            return false;
+        }
+    }
+
+    /*
+     * Merge in partition order. Partition 0 declares every function in
+     * the original order, so the merged module keeps that order too.
+     */
+    auto Merged = llvm::make_unique<llvm::Module>(M->getModuleIdentifier(), Context);
+    Merged->setTargetTriple(M->getTargetTriple());
+    Merged->setDataLayout(M->getDataLayout());
+    Merged->setSourceFileName(M->getSourceFileName());
+    for (size_t i = 0; i < Partitions.size(); i++)
+    {
+        auto Buffer = llvm::MemoryBuffer::getMemBuffer(Bitcode[i].str(), "", false);
+        auto PartitionOrErr = llvm::parseBitcodeFile(Buffer->getMemBufferRef(), Context);
+        if (!PartitionOrErr || llvm::Linker::linkModules(*Merged, std::move(*PartitionOrErr)))
+        {
+            if (!PartitionOrErr)
+                llvm::consumeError(PartitionOrErr.takeError());
+            reportDiagnostic("slang:\033[1;31m error:\033[0m could not merge optimized partition %zu\n", i);
+            countError();
+            return false;
+        }
+    }
+    // A module without function definitions has no partitions.
+    if (!Partitions.empty())
+        M = std::move(Merged);
+
+    llvm::legacy::PassManager CleanupPM;
+    addTargetAnalysisPasses(CleanupPM, TM);
+    addParallelCleanupPasses(CleanupPM);
+    if (!DontVerify)
+        addPass(CleanupPM, llvm::createVerifierPass());
+    CleanupPM.run(*M);
+    return true;
 }
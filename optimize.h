@@ -1,7 +1,13 @@
 #ifndef SLANG_OPTIMIZE_H
 #define SLANG_OPTIMIZE_H
 
+#include <functional>
+#include <memory>
+#include <string>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Target/TargetMachine.h>
 
 class Optimizer
 {
@@ -9,16 +15,42 @@ public:
     Optimizer() :
             OptimizationLevel(0),
             DontVerify(true),
-            VerifyEach(false)
+            VerifyEach(false),
+            TM(nullptr),
+            Threads(0),
+            ProfileGenerate(false)
     {}
 
     ~Optimizer() = default;
 
     void addStandardCompilePasses(llvm::legacy::PassManager &PM);
 
+    /*
+     * optimize: run the standard pipeline on a module. With Threads > 0 the
+     * function-level passes run on a thread pool, see optimizeInParallel().
+     * Partitions are cut by function count, not by thread count, so every
+     * Threads > 0 gives the same module. It is not the module of the serial
+     * pipeline: the IPO cleanup sees one partition at a time and the merged
+     * module gets a cleanup of its own. bench/parallel_opt.sh checks this.
+     * @param M -- the module, replaced by the optimized one in parallel mode.
+     * @return false if the parallel mode failed, the error is reported and counted.
+     */
+    bool optimize(std::unique_ptr<llvm::Module> &M);
+
     int OptimizationLevel;
     bool DontVerify;
     bool VerifyEach;
+    // Target used for cost-model decisions, nullptr for the default TTI.
+    llvm::TargetMachine *TM;
+    // Worker threads for function passes, 0 runs the whole pipeline serially, see optimize().
+    unsigned Threads;
+    // Creates a private TargetMachine for each worker, TargetMachines are not thread safe.
+    std::function<std::unique_ptr<llvm::TargetMachine>()> TMFactory;
+    // Insert InstrProf counters, the raw profile is written to ProfileGenerateDir at exit.
+    bool ProfileGenerate;
+    std::string ProfileGenerateDir;
+    // Indexed profile (llvm-profdata merge) to read branch weights and entry counts from.
+    std::string ProfileUseFile;
 
 private:
     void addPass(llvm::legacy::PassManager &PM, llvm::Pass *P)
@@ -30,6 +62,31 @@ private:
         if (VerifyEach)
             PM.add(llvm::createVerifierPass());
     }
+
+    void addTargetAnalysisPasses(llvm::legacy::PassManager &PM, llvm::TargetMachine *Target);
+
+    // Profile instrumentation or annotation, ahead of inlining so it can use the counts.
+    void addProfilePasses(llvm::legacy::PassManager &PM);
+
+    // Interprocedural part of the pipeline, runs serially on the whole module.
+    void addModulePasses(llvm::legacy::PassManager &PM);
+
+    // Function passes cleaning up after IPCP & DAE, PruneEH follows them in the serial pipeline.
+    void addIPOCleanupPasses(llvm::legacy::PassManager &PM);
+
+    // Per-function part of the pipeline, safe to run on any subset of the functions.
+    void addFunctionPasses(llvm::legacy::PassManager &PM);
+
+    // Whole-module cleanup after the partitions of the parallel mode are merged.
+    void addParallelCleanupPasses(llvm::legacy::PassManager &PM);
+
+    bool optimizeInParallel(std::unique_ptr<llvm::Module> &M);
 };
 
+/*
+ * parseOptimizationLevel: numeric level of an optimization flag such as "-O2".
+ * @param flag -- the flag as given on the command line.
+ */
+int parseOptimizationLevel(const std::string &flag);
+
 #endif //SLANG_OPTIMIZE_H
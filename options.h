@@ -0,0 +1,87 @@
+#ifndef SLANG_OPTIONS_H
+#define SLANG_OPTIONS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Runtime search paths of the in-process link, found by CMake on the build host.
+#ifndef SLANG_CRT_DIR
+#define SLANG_CRT_DIR "/usr/lib/x86_64-linux-gnu"
+#endif
+#ifndef SLANG_GCC_RUNTIME_DIR
+#define SLANG_GCC_RUNTIME_DIR "/usr/lib/gcc/x86_64-linux-gnu/7"
+#endif
+#ifndef SLANG_DYNAMIC_LINKER
+#define SLANG_DYNAMIC_LINKER "/lib64/ld-linux-x86-64.so.2"
+#endif
+
+/*
+ * Options: everything that controls a compile. The command line fills one
+ * in; library users build their own and pass it to CompilerInstance::compile().
+ */
+struct Options
+{
+    // Name of the input in diagnostics, debug info and the object's symbol table.
+    std::string InputName = "<input>";
+    // Input name without extension, used to name side outputs.
+    std::string Prefix;
+
+    // Output kind: object code unless one of these is set.
+    bool EmitIR = false;
+    bool EmitASM = false;
+    bool EmitBC = false;
+    // -emit-ast: the AST in the format of ast_binary.h, nothing is compiled.
+    bool EmitAST = false;
+    // Also produce textual IR, bitcode and assembly of the optimized module.
+    bool SaveTemps = false;
+    // -c: the output is the final product rather than input to the link step.
+    bool DontLink = false;
+    std::string OutputFile;
+
+    // Optimization.
+    std::string OptimizationLevel = "-O0";
+    // Fold constants in the AST before IR generation, and drop the branches it
+    // finds dead once the program is checked.
+    bool FoldAST = true;
+    bool FoldASTStats = false;
+    // Lower the AST to the mid-level IR of mir.h and generate IR from it, falling
+    // back to IR generation from the AST for what it does not lower.
+    bool MIR = false;
+    bool MIRStats = false;
+    bool DumpMIR = false;
+    // Trap on array subscripts out of bounds, only in the MIR.
+    bool BoundsCheck = false;
+    unsigned OptimizationThreads = 0;
+    unsigned CodeGenPartitions = 1;
+    bool ProfileGenerate = false;
+    std::string ProfileGenerateDir;
+    std::string ProfileUseFile;
+    bool ThinLTO = false;
+
+    // Target.
+    std::string TargetTripleName;
+    std::string TargetCPU = "generic";
+    std::string TargetFeatures;
+    std::string TargetTuneCPU;
+
+    // Optimization remarks.
+    std::string RemarksPassed;
+    std::string RemarksMissed;
+    std::string RemarksAnalysis;
+    bool SaveOptimizationRecord = false;
+    std::string OptimizationRecordFile;
+
+    // Compilation cache, off while CacheDir is empty.
+    std::string CacheDir;
+    uint64_t CacheMaxSize = 1024ull << 20;
+
+    // Link step.
+    std::string UseLinker = "lld";
+    std::string CRTDir = SLANG_CRT_DIR;
+    std::string GCCRuntimeDir = SLANG_GCC_RUNTIME_DIR;
+    std::string DynamicLinker = SLANG_DYNAMIC_LINKER;
+    std::vector<std::string> LibraryDirs;
+};
+
+#endif //SLANG_OPTIONS_H
@@ -3,22 +3,30 @@
     #include <cstdio>
     #include <string>
     #include "absyn.h"
+    #include "diagnostics.h"
+%}
+
+%code requires
+{
+    #include "parser_state.h"
+
+    typedef void *yyscan_t;
+}
 
-    AST_Block* programBlock;
-    bool emptyFile;
-    extern int yylex();
-    extern int yyrow;
-    extern int yycol;
-    extern const char* yyfile;
+%code
+{
+    int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner);
 
-    void yyerror(const char *s)
+    void yyerror(yyscan_t scanner, ParserState *state, const char *s)
     {
-    	fflush(stdout);
-    	fprintf(stderr, "\033[1m%s:%d:%d:\033[1;31m error: \033[0m", yyfile, yyrow, yycol);
-    	fprintf(stderr, "\033[1m%s\033[0m\n", s);
+        state->errors++;
+    	reportDiagnostic("\033[1m%s:%d:%d:\033[1;31m error: \033[0m\033[1m%s\033[0m\n", state->filename, state->row, state->col, s);
     }
-%}
+}
 
+%define api.pure full
+%param {yyscan_t scanner}
+%parse-param {ParserState *state}
 %define parse.lac full
 %define parse.error verbose
 
@@ -76,12 +84,12 @@
 %%
 
 program
-    : /* empty file */ {emptyFile = true; return 0;}
-    | translation_unit {programBlock = $1;}
+    : /* empty file */ {state->emptyFile = true; return 0;}
+    | translation_unit {state->programBlock = std::shared_ptr<AST_Block>($1);}
     ;
 
 translation_unit
-    : statement                     {$$ = new AST_Block(); $$->col = yycol; $$->row = yyrow; $$->statements->push_back(std::shared_ptr<AST_Statement>($1));}
+    : statement                     {$$ = new AST_Block(); $$->col = state->col; $$->row = state->row; $$->statements->push_back(std::shared_ptr<AST_Statement>($1));}
     | translation_unit statement    {$1->statements->push_back(std::shared_ptr<AST_Statement>($2)); $$ = $1;}
     ;
 
@@ -93,12 +101,12 @@ statement
     ;
 
 primary_typename
-    : INT       {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; $$->isType = true; delete $1;}
-    | DOUBLE    {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; $$->isType = true; delete $1;}
-    | FLOAT     {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; $$->isType = true; delete $1;}
-    | CHAR      {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; $$->isType = true; delete $1;}
-    | BOOL      {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; $$->isType = true; delete $1;}
-    | VOID      {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; $$->isType = true; delete $1;}
+    : INT       {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; $$->isType = true; delete $1;}
+    | DOUBLE    {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; $$->isType = true; delete $1;}
+    | FLOAT     {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; $$->isType = true; delete $1;}
+    | CHAR      {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; $$->isType = true; delete $1;}
+    | BOOL      {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; $$->isType = true; delete $1;}
+    | VOID      {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; $$->isType = true; delete $1;}
     ;
 
 struct_typename
@@ -111,21 +119,21 @@ type_specifier
     ;
 
 array_declaration
-    : type_specifier id '[' I_CONSTANT ']'  {$1->isArray = true; $1->arraySize->push_back(make_shared<AST_Integer>(atol($4->c_str()))); $$ = new AST_VariableDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), nullptr); $$->col = yycol; $$->row = yyrow;}
+    : type_specifier id '[' I_CONSTANT ']'  {$1->isArray = true; $1->arraySize->push_back(make_shared<AST_Integer>(atol($4->c_str()))); $$ = new AST_VariableDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), nullptr); $$->col = state->col; $$->row = state->row;}
     | array_declaration '[' I_CONSTANT ']'  {$1->type->arraySize->push_back(make_shared<AST_Integer>(atol($3->c_str()))); $$ = $1;}
     ;
 
 variable_declaration
-    : type_specifier id                                         {$$ = new AST_VariableDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), nullptr); $$->col = yycol; $$->row = yyrow;}
-    | type_specifier id '=' expression                          {$$ = new AST_VariableDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_Expression>($4)); $$->col = yycol; $$->row = yyrow;}
+    : type_specifier id                                         {$$ = new AST_VariableDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), nullptr); $$->col = state->col; $$->row = state->row;}
+    | type_specifier id '=' expression                          {$$ = new AST_VariableDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_Expression>($4)); $$->col = state->col; $$->row = state->row;}
     | array_declaration                                         {$$ = $1;}
-    | array_declaration '=' '{' argument_expression_list '}'    {$$ = new AST_ArrayInitialization(std::shared_ptr<AST_VariableDeclaration>($1), std::shared_ptr<AST_ExpressionList>($4)); $$->col = yycol; $$->row = yyrow;}
+    | array_declaration '=' '{' argument_expression_list '}'    {$$ = new AST_ArrayInitialization(std::shared_ptr<AST_VariableDeclaration>($1), std::shared_ptr<AST_ExpressionList>($4)); $$->col = state->col; $$->row = state->row;}
     ;
 
 function_declaration
-    : type_specifier id '(' parameter_list ')' block        {$$ = new AST_FunctionDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_VariableList>($4), std::shared_ptr<AST_Block>($6)); $$->col = yycol; $$->row = yyrow;}
-    | type_specifier id '(' parameter_list ')' ';'          {$$ = new AST_FunctionDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_VariableList>($4), nullptr, true); $$->col = yycol; $$->row = yyrow;}
-    | EXTERN type_specifier id '(' parameter_list ')' ';'   {$$ = new AST_FunctionDeclaration(std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_VariableList>($5), nullptr, true); $$->col = yycol; $$->row = yyrow;}
+    : type_specifier id '(' parameter_list ')' block        {$$ = new AST_FunctionDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_VariableList>($4), std::shared_ptr<AST_Block>($6)); $$->col = state->col; $$->row = state->row;}
+    | type_specifier id '(' parameter_list ')' ';'          {$$ = new AST_FunctionDeclaration(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_VariableList>($4), nullptr, true); $$->col = state->col; $$->row = state->row;}
+    | EXTERN type_specifier id '(' parameter_list ')' ';'   {$$ = new AST_FunctionDeclaration(std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_VariableList>($5), nullptr, true); $$->col = state->col; $$->row = state->row;}
     ;
 
 parameter_list
@@ -135,7 +143,7 @@ parameter_list
     ;
 
 struct_declaration
-    : STRUCT id '{' struct_declaration_list '}' ';' {$$ = new AST_StructDeclaration(std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_VariableList>($4)); $$->col = yycol; $$->row = yyrow;}
+    : STRUCT id '{' struct_declaration_list '}' ';' {$$ = new AST_StructDeclaration(std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_VariableList>($4)); $$->col = state->col; $$->row = state->row;}
     ;
 
 struct_declaration_list
@@ -144,29 +152,29 @@ struct_declaration_list
     ;
 
 expression_statement
-    : ';'               {AST_Expression* empty = new AST_Expression(); $$ = new AST_ExpressionStatement(std::shared_ptr<AST_Expression>(empty)); $$->col = yycol; $$->row = yyrow;}
-    | expression ';'    {$$ = new AST_ExpressionStatement(std::shared_ptr<AST_Expression>($1)); $$->col = yycol; $$->row = yyrow;}
+    : ';'               {AST_Expression* empty = new AST_Expression(); $$ = new AST_ExpressionStatement(std::shared_ptr<AST_Expression>(empty)); $$->col = state->col; $$->row = state->row;}
+    | expression ';'    {$$ = new AST_ExpressionStatement(std::shared_ptr<AST_Expression>($1)); $$->col = state->col; $$->row = state->row;}
     ;
 
 selection_statement
-    : IF '(' expression ')' block ELSE block                {$$ = new AST_IfStatement(std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Block>($5), std::shared_ptr<AST_Block>($7)); $$->col = yycol; $$->row = yyrow;}
-    | IF '(' expression ')' block ELSE selection_statement  {auto tmp_block = new AST_Block(); tmp_block->col = yycol; tmp_block->row = yyrow; tmp_block->statements->push_back(std::shared_ptr<AST_Statement>($7)); $$ = new AST_IfStatement(std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Block>($5), std::shared_ptr<AST_Block>(tmp_block)); $$->col = yycol; $$->row = yyrow;}
-    | IF '(' expression ')' block %prec LOWER_THAN_ELSE     {$$ = new AST_IfStatement(std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Block>($5)); $$->col = yycol; $$->row = yyrow;}
+    : IF '(' expression ')' block ELSE block                {$$ = new AST_IfStatement(std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Block>($5), std::shared_ptr<AST_Block>($7)); $$->col = state->col; $$->row = state->row;}
+    | IF '(' expression ')' block ELSE selection_statement  {auto tmp_block = new AST_Block(); tmp_block->col = state->col; tmp_block->row = state->row; tmp_block->statements->push_back(std::shared_ptr<AST_Statement>($7)); $$ = new AST_IfStatement(std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Block>($5), std::shared_ptr<AST_Block>(tmp_block)); $$->col = state->col; $$->row = state->row;}
+    | IF '(' expression ')' block %prec LOWER_THAN_ELSE     {$$ = new AST_IfStatement(std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Block>($5)); $$->col = state->col; $$->row = state->row;}
     ;
 
 iteration_statement
-    : WHILE '(' expression ')' block                                {$$ = new AST_ForStatement(std::shared_ptr<AST_Block>($5), nullptr, std::shared_ptr<AST_Expression>($3), nullptr); $$->col = yycol; $$->row = yyrow;}
-    | DO block WHILE '(' expression ')'                             {$$ = new AST_ForStatement(std::shared_ptr<AST_Block>($2), nullptr, std::shared_ptr<AST_Expression>($5), nullptr); $$->atLeastOnce = true; $$->col = yycol; $$->row = yyrow;}
-    | FOR '(' expression ';' expression ';' expression ')' block    {$$ = new AST_ForStatement(std::shared_ptr<AST_Block>($9), std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Expression>($5), std::shared_ptr<AST_Expression>($7)); $$->col = yycol; $$->row = yyrow;}
+    : WHILE '(' expression ')' block                                {$$ = new AST_ForStatement(std::shared_ptr<AST_Block>($5), nullptr, std::shared_ptr<AST_Expression>($3), nullptr); $$->col = state->col; $$->row = state->row;}
+    | DO block WHILE '(' expression ')'                             {$$ = new AST_ForStatement(std::shared_ptr<AST_Block>($2), nullptr, std::shared_ptr<AST_Expression>($5), nullptr); $$->atLeastOnce = true; $$->col = state->col; $$->row = state->row;}
+    | FOR '(' expression ';' expression ';' expression ')' block    {$$ = new AST_ForStatement(std::shared_ptr<AST_Block>($9), std::shared_ptr<AST_Expression>($3), std::shared_ptr<AST_Expression>($5), std::shared_ptr<AST_Expression>($7)); $$->col = state->col; $$->row = state->row;}
     ;
 
 jump_statement
-    : RETURN ';'            {AST_Expression* empty = new AST_Expression(); $$ = new AST_ReturnStatement(std::shared_ptr<AST_Expression>(empty)); $$->col = yycol; $$->row = yyrow;}
-    | RETURN expression ';' {$$ = new AST_ReturnStatement(std::shared_ptr<AST_Expression>($2)); $$->col = yycol; $$->row = yyrow;}
+    : RETURN ';'            {AST_Expression* empty = new AST_Expression(); $$ = new AST_ReturnStatement(std::shared_ptr<AST_Expression>(empty)); $$->col = state->col; $$->row = state->row;}
+    | RETURN expression ';' {$$ = new AST_ReturnStatement(std::shared_ptr<AST_Expression>($2)); $$->col = state->col; $$->row = state->row;}
     ;
 
 local_statement_list
-    : local_statement                       {$$ = new AST_Block(); $$->col = yycol; $$->row = yyrow; $$->statements->push_back(std::shared_ptr<AST_Statement>($1));}
+    : local_statement                       {$$ = new AST_Block(); $$->col = state->col; $$->row = state->row; $$->statements->push_back(std::shared_ptr<AST_Statement>($1));}
     | local_statement_list local_statement  {$1->statements->push_back(std::shared_ptr<AST_Statement>($2)); $$ = $1;}
     ;
 
@@ -181,20 +189,20 @@ local_statement
 
 block
     : '{' local_statement_list '}'  {$$ = $2;}
-    | '{' '}'                       {$$ = new AST_Block(); $$->col = yycol; $$->row = yyrow;}
+    | '{' '}'                       {$$ = new AST_Block(); $$->col = state->col; $$->row = state->row;}
     ;
 
 id
-    : IDENTIFIER {$$ = new AST_Identifier(*$1); $$->col = yycol; $$->row = yyrow; delete $1;}
+    : IDENTIFIER {$$ = new AST_Identifier(*$1); $$->col = state->col; $$->row = state->row; delete $1;}
     ;
 
 constant
-    : I_CONSTANT {$$ = new AST_Integer(atol($1->c_str())); $$->col = yycol; $$->row = yyrow; delete $1;}
-    | F_CONSTANT {$$ = new AST_Double(atof($1->c_str())); $$->col = yycol; $$->row = yyrow; delete $1;}
+    : I_CONSTANT {$$ = new AST_Integer(atol($1->c_str())); $$->col = state->col; $$->row = state->row; delete $1;}
+    | F_CONSTANT {$$ = new AST_Double(atof($1->c_str())); $$->col = state->col; $$->row = state->row; delete $1;}
     ;
 
 string
-    : STRING_LITERAL {std::string temp = $1->substr(1, $1->length() - 2); $$ = new AST_Literal(temp); $$->col = yycol; $$->row = yyrow; delete $1;}
+    : STRING_LITERAL {std::string temp = $1->substr(1, $1->length() - 2); $$ = new AST_Literal(temp); $$->col = state->col; $$->row = state->row; delete $1;}
     ;
 
 expression
@@ -203,14 +211,14 @@ expression
 
 assignment_expression
     : logical_or_expression                                         {$$ = $1;}
-    | id '=' assignment_expression                                  {$$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | array_index '=' assignment_expression                         {$$ = new AST_ArrayAssignment(std::shared_ptr<AST_ArrayIndex>($1), std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | id '.' id '=' assignment_expression                           {auto member = std::make_shared<AST_StructMember>(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($3)); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>($5)); $$->col = yycol; $$->row = yyrow;}
-    | array_index '.' id '=' assignment_expression                  {auto member = std::make_shared<AST_StructMember>(std::shared_ptr<AST_Identifier>($1->arrayName), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_ArrayIndex>($1), true); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>($5)); $$->col = yycol; $$->row = yyrow;}
-    | id assignment_operator assignment_expression                  {auto expr = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>(expr)); $$->col = yycol; $$->row = yyrow;}
-    | array_index assignment_operator assignment_expression         {auto expr = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$ = new AST_ArrayAssignment(std::shared_ptr<AST_ArrayIndex>($1), std::shared_ptr<AST_Expression>(expr)); $$->col = yycol; $$->row = yyrow;}
-    | id '.' id assignment_operator assignment_expression           {auto expr = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $4, std::shared_ptr<AST_Expression>($3)); auto member = std::make_shared<AST_StructMember>(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($3)); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>(expr)); $$->col = yycol; $$->row = yyrow;}
-    | array_index '.' id assignment_operator assignment_expression  {auto expr = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $4, std::shared_ptr<AST_Expression>($3)); auto member = std::make_shared<AST_StructMember>(std::shared_ptr<AST_Identifier>($1->arrayName), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_ArrayIndex>($1), true); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>(expr)); $$->col = yycol; $$->row = yyrow;}
+    | id '=' assignment_expression                                  {$$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | array_index '=' assignment_expression                         {$$ = new AST_ArrayAssignment(std::shared_ptr<AST_ArrayIndex>($1), std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | id '.' id '=' assignment_expression                           {auto member = std::make_shared<AST_StructMember>(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($3)); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>($5)); $$->col = state->col; $$->row = state->row;}
+    | array_index '.' id '=' assignment_expression                  {auto member = std::make_shared<AST_StructMember>(std::shared_ptr<AST_Identifier>($1->arrayName), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_ArrayIndex>($1), true); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>($5)); $$->col = state->col; $$->row = state->row;}
+    | id assignment_operator assignment_expression                  {auto id = std::shared_ptr<AST_Identifier>($1); auto expr = new AST_BinaryOperator(id, $2, std::shared_ptr<AST_Expression>($3)); $$ = new AST_Assignment(id, std::shared_ptr<AST_Expression>(expr)); $$->col = state->col; $$->row = state->row;}
+    | array_index assignment_operator assignment_expression         {auto index = std::shared_ptr<AST_ArrayIndex>($1); auto expr = new AST_BinaryOperator(index, $2, std::shared_ptr<AST_Expression>($3)); $$ = new AST_ArrayAssignment(index, std::shared_ptr<AST_Expression>(expr)); $$->col = state->col; $$->row = state->row;}
+    | id '.' id assignment_operator assignment_expression           {auto structName = std::shared_ptr<AST_Identifier>($1); auto memberName = std::shared_ptr<AST_Identifier>($3); auto expr = new AST_BinaryOperator(structName, $4, memberName); auto member = std::make_shared<AST_StructMember>(structName, memberName); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>(expr)); $$->col = state->col; $$->row = state->row;}
+    | array_index '.' id assignment_operator assignment_expression  {auto index = std::shared_ptr<AST_ArrayIndex>($1); auto memberName = std::shared_ptr<AST_Identifier>($3); auto expr = new AST_BinaryOperator(index, $4, memberName); auto member = std::make_shared<AST_StructMember>(index->arrayName, memberName, index, true); $$ = new AST_StructAssignment(member, std::shared_ptr<AST_Expression>(expr)); $$->col = state->col; $$->row = state->row;}
     ;
 
 assignment_operator
@@ -228,80 +236,80 @@ assignment_operator
 
 logical_or_expression
     : logical_and_expression                                {$$ = $1;}
-    | logical_or_expression OR_OP logical_and_expression    {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | logical_or_expression OR_OP logical_and_expression    {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 logical_and_expression
     : inclusive_or_expression                               {$$ = $1;}
-    | logical_and_expression AND_OP inclusive_or_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | logical_and_expression AND_OP inclusive_or_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 inclusive_or_expression
     : exclusive_or_expression                                   {$$ = $1;}
-    | inclusive_or_expression BIT_OR_OP exclusive_or_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | inclusive_or_expression BIT_OR_OP exclusive_or_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 exclusive_or_expression
     : and_expression                                    {$$ = $1;}
-    | exclusive_or_expression BIT_XOR_OP and_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | exclusive_or_expression BIT_XOR_OP and_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 and_expression
     : equality_expression                           {$$ = $1;}
-    | and_expression BIT_AND_OP equality_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | and_expression BIT_AND_OP equality_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 equality_expression
     : relational_expression                             {$$ = $1;}
-    | equality_expression EQ_OP relational_expression   {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | equality_expression NE_OP relational_expression   {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | equality_expression EQ_OP relational_expression   {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | equality_expression NE_OP relational_expression   {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 relational_expression
     : shift_expression                              {$$ = $1;}
-    | relational_expression LT_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | relational_expression GT_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | relational_expression LE_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | relational_expression GE_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | relational_expression LT_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | relational_expression GT_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | relational_expression LE_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | relational_expression GE_OP shift_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 shift_expression
     : additive_expression                           {$$ = $1;}
-    | shift_expression LEFT_OP additive_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | shift_expression RIGHT_OP additive_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | shift_expression LEFT_OP additive_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | shift_expression RIGHT_OP additive_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 additive_expression
     : multiplicative_expression                             {$$ = $1;}
-    | additive_expression ADD_OP multiplicative_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | additive_expression SUB_OP multiplicative_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | additive_expression ADD_OP multiplicative_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | additive_expression SUB_OP multiplicative_expression  {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 multiplicative_expression
     : unary_expression                                  {$$ = $1;}
-    | multiplicative_expression MUL_OP unary_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | multiplicative_expression DIV_OP unary_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
-    | multiplicative_expression MOD_OP unary_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    | multiplicative_expression MUL_OP unary_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | multiplicative_expression DIV_OP unary_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
+    | multiplicative_expression MOD_OP unary_expression {$$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), $2, std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     ;
 
 unary_expression
     : postfix_expression        {$$ = $1;}
-    | SUB_OP postfix_expression {auto zero = new AST_Integer(0); $$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>(zero), SUB_OP, std::shared_ptr<AST_Expression>($2)); $$->col = yycol; $$->row = yyrow;}
-    | '~' postfix_expression    {auto neg = new AST_Integer(0xffffffffffffffff); $$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>(neg), BIT_XOR_OP, std::shared_ptr<AST_Expression>($2)); $$->col = yycol; $$->row = yyrow;}
-    | '!' postfix_expression    {auto neg = new AST_Integer(0xffffffffffffffff); $$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>(neg), BIT_XOR_OP, std::shared_ptr<AST_Expression>($2)); $$->col = yycol; $$->row = yyrow;}
-    | INC_OP id                 {auto one = new AST_Integer(1); auto inc = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($2), ADD_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_Expression>(inc)); $$->col = yycol; $$->row = yyrow;}
-    | DEC_OP id                 {auto one = new AST_Integer(1); auto dec = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($2), SUB_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($2), std::shared_ptr<AST_Expression>(dec)); $$->col = yycol; $$->row = yyrow;}
+    | SUB_OP postfix_expression {auto zero = new AST_Integer(0); $$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>(zero), SUB_OP, std::shared_ptr<AST_Expression>($2)); $$->col = state->col; $$->row = state->row;}
+    | '~' postfix_expression    {auto neg = new AST_Integer(0xffffffffffffffff); $$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>(neg), BIT_XOR_OP, std::shared_ptr<AST_Expression>($2)); $$->col = state->col; $$->row = state->row;}
+    | '!' postfix_expression    {auto neg = new AST_Integer(0xffffffffffffffff); $$ = new AST_BinaryOperator(std::shared_ptr<AST_Expression>(neg), BIT_XOR_OP, std::shared_ptr<AST_Expression>($2)); $$->col = state->col; $$->row = state->row;}
+    | INC_OP id                 {auto id = std::shared_ptr<AST_Identifier>($2); auto one = new AST_Integer(1); auto inc = new AST_BinaryOperator(id, ADD_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(id, std::shared_ptr<AST_Expression>(inc)); $$->col = state->col; $$->row = state->row;}
+    | DEC_OP id                 {auto id = std::shared_ptr<AST_Identifier>($2); auto one = new AST_Integer(1); auto dec = new AST_BinaryOperator(id, SUB_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(id, std::shared_ptr<AST_Expression>(dec)); $$->col = state->col; $$->row = state->row;}
     ;
 
 postfix_expression
     : primary_expression                    {$$ = $1;}
     | array_index                           {$$ = $1;}
-    | id '.' id                             {$$ = new AST_StructMember(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($3)); $$->col = yycol; $$->row = yyrow;}
-    | array_index '.' id                    {$$ = new AST_StructMember(std::shared_ptr<AST_Identifier>($1->arrayName), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_ArrayIndex>($1), true); $$->col = yycol; $$->row = yyrow;}
-    | id '(' ')'                            {$$ = new AST_MethodCall(std::shared_ptr<AST_Identifier>($1)); $$->col = yycol; $$->row = yyrow;}
-    | id '(' argument_expression_list ')'   {$$ = new AST_MethodCall(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_ExpressionList>($3)); $$->col = yycol; $$->row = yyrow;}
-    | id INC_OP                             {auto one = new AST_Integer(1); auto inc = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), ADD_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>(inc)); $$->col = yycol; $$->row = yyrow;}
-    | id DEC_OP                             {auto one = new AST_Integer(1); auto dec = new AST_BinaryOperator(std::shared_ptr<AST_Expression>($1), SUB_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>(dec)); $$->col = yycol; $$->row = yyrow;}
+    | id '.' id                             {$$ = new AST_StructMember(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Identifier>($3)); $$->col = state->col; $$->row = state->row;}
+    | array_index '.' id                    {$$ = new AST_StructMember(std::shared_ptr<AST_Identifier>($1->arrayName), std::shared_ptr<AST_Identifier>($3), std::shared_ptr<AST_ArrayIndex>($1), true); $$->col = state->col; $$->row = state->row;}
+    | id '(' ')'                            {$$ = new AST_MethodCall(std::shared_ptr<AST_Identifier>($1)); $$->col = state->col; $$->row = state->row;}
+    | id '(' argument_expression_list ')'   {$$ = new AST_MethodCall(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_ExpressionList>($3)); $$->col = state->col; $$->row = state->row;}
+    | id INC_OP                             {auto id = std::shared_ptr<AST_Identifier>($1); auto one = new AST_Integer(1); auto inc = new AST_BinaryOperator(id, ADD_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(id, std::shared_ptr<AST_Expression>(inc)); $$->col = state->col; $$->row = state->row;}
+    | id DEC_OP                             {auto id = std::shared_ptr<AST_Identifier>($1); auto one = new AST_Integer(1); auto dec = new AST_BinaryOperator(id, SUB_OP, std::shared_ptr<AST_Expression>(one)); $$ = new AST_Assignment(id, std::shared_ptr<AST_Expression>(dec)); $$->col = state->col; $$->row = state->row;}
     ;
 
 primary_expression
@@ -312,7 +320,7 @@ primary_expression
     ;
 
 array_index
-    : id '[' expression ']'             {$$ = new AST_ArrayIndex(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>($3)); $$->col = yycol; $$->row = yyrow;}
+    : id '[' expression ']'             {$$ = new AST_ArrayIndex(std::shared_ptr<AST_Identifier>($1), std::shared_ptr<AST_Expression>($3)); $$->col = state->col; $$->row = state->row;}
     | array_index '[' expression ']'    {$1->expressions->push_back(std::shared_ptr<AST_Expression>($3)); $$ = $1;}
     ;
 
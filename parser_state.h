@@ -0,0 +1,33 @@
+#ifndef SLANG_PARSER_STATE_H
+#define SLANG_PARSER_STATE_H
+
+#include <istream>
+#include <memory>
+
+class AST_Block;
+
+/*
+ * ParserState: everything the scanner and the parser keep about one input.
+ * Each parse owns its state, so inputs can be parsed on several threads.
+ */
+struct ParserState
+{
+    // Read by the scanner's YY_INPUT.
+    std::istream *input = nullptr;
+    const char *filename = "";
+    // Position of the scanner, stamped on every AST node.
+    int row = 1;
+    int col = 1;
+    int errors = 0;
+    bool emptyFile = false;
+    std::shared_ptr<AST_Block> programBlock;
+};
+
+/*
+ * parseProgram: lex and parse one input with a scanner of its own.
+ * Syntax errors are reported through reportDiagnostic().
+ * @return false if the input has syntax errors.
+ */
+bool parseProgram(ParserState &state);
+
+#endif //SLANG_PARSER_STATE_H
@@ -0,0 +1,133 @@
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/Support/Regex.h>
+#include <llvm/Support/YAMLTraits.h>
+#include <llvm/Support/raw_ostream.h>
+#include "diagnostics.h"
+#include "remarks.h"
+
+/*
+ * createFilter: compile a -Rpass* regular expression, left empty if the option was not given.
+ * @return false if the regular expression is invalid.
+ */
+static bool createFilter(const std::string &pattern, const char *option, std::shared_ptr<Regex> &filter)
+{
+    if (pattern.empty())
+    {
+        return true;
+    }
+    filter = std::make_shared<Regex>(pattern);
+    std::string error;
+    if (!filter->isValid(error))
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m invalid regular expression '%s' in '%s': %s\n",
+                         pattern.c_str(), option, error.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*
+ * RemarkHandler: prints the remarks whose pass name matches a -Rpass* filter,
+ * in the same format as the front end's errors.
+ */
+class RemarkHandler : public DiagnosticHandler
+{
+public:
+    std::shared_ptr<Regex> passed;
+    std::shared_ptr<Regex> missed;
+    std::shared_ptr<Regex> analysis;
+    bool record = false;
+
+    bool isPassedOptRemarkEnabled(StringRef PassName) const override
+    {
+        return passed && passed->match(PassName);
+    }
+
+    bool isMissedOptRemarkEnabled(StringRef PassName) const override
+    {
+        return missed && missed->match(PassName);
+    }
+
+    bool isAnalysisRemarkEnabled(StringRef PassName) const override
+    {
+        return analysis && analysis->match(PassName);
+    }
+
+    bool isAnyRemarkEnabled() const override
+    {
+        // The passes only build remarks when someone listens, the YAML record included.
+        return passed || missed || analysis || record;
+    }
+
+    bool handleDiagnostics(const DiagnosticInfo &DI) override
+    {
+        auto *remark = dyn_cast<DiagnosticInfoOptimizationBase>(&DI);
+        if (!remark)
+        {
+            // Not a remark, let LLVM print it.
+            return false;
+        }
+
+        const char *option;
+        if (remark->isPassed() && isPassedOptRemarkEnabled(remark->getPassName()))
+        {
+            option = "-Rpass";
+        } else if (remark->isMissed() && isMissedOptRemarkEnabled(remark->getPassName()))
+        {
+            option = "-Rpass-missed";
+        } else if (remark->isAnalysis() && isAnalysisRemarkEnabled(remark->getPassName()))
+        {
+            option = "-Rpass-analysis";
+        } else
+        {
+            return true;
+        }
+
+        if (remark->isLocationAvailable())
+        {
+            StringRef file;
+            unsigned line = 0;
+            unsigned column = 0;
+            remark->getLocation(&file, &line, &column);
+            reportDiagnostic("\033[1m%s:%u:%u:\033[1;34m remark: \033[0m", file.str().c_str(), line, column);
+        } else
+        {
+            // Code the front end made up, e.g. a global initializer.
+            reportDiagnostic("\033[1m%s:\033[1;34m remark: \033[0m", diagnosticFile());
+        }
+        reportDiagnostic("%s [%s=%s]\n", remark->getMsg().c_str(), option, remark->getPassName().str().c_str());
+        return true;
+    }
+};
+
+bool remarksRequested(const Options &options)
+{
+    return !options.RemarksPassed.empty() || !options.RemarksMissed.empty() || !options.RemarksAnalysis.empty() ||
+           options.SaveOptimizationRecord;
+}
+
+bool setupRemarks(CodeGenContext &context)
+{
+    const Options &options = context.options;
+    auto handler = llvm::make_unique<RemarkHandler>();
+    if (!createFilter(options.RemarksPassed, "-Rpass", handler->passed) ||
+        !createFilter(options.RemarksMissed, "-Rpass-missed", handler->missed) ||
+        !createFilter(options.RemarksAnalysis, "-Rpass-analysis", handler->analysis))
+    {
+        return false;
+    }
+    handler->record = options.SaveOptimizationRecord;
+    context.llvmContext.setDiagnosticHandler(std::move(handler));
+
+    if (options.SaveOptimizationRecord)
+    {
+        // The caller decides where the record goes, see CompileResult::optimizationRecord.
+        context.optimizationRecordStream = llvm::make_unique<raw_string_ostream>(context.optimizationRecord);
+        context.llvmContext.setDiagnosticsOutputFile(
+                llvm::make_unique<yaml::Output>(*context.optimizationRecordStream));
+    }
+
+    context.enableDebugLocations(options.InputName);
+    return true;
+}
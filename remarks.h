@@ -0,0 +1,23 @@
+#ifndef SLANG_REMARKS_H
+#define SLANG_REMARKS_H
+
+#include "IR.h"
+#include "options.h"
+
+/*
+ * remarksRequested: whether -Rpass, -Rpass-missed, -Rpass-analysis or
+ * -fsave-optimization-record asked for optimization remarks.
+ */
+bool remarksRequested(const Options &options);
+
+/*
+ * setupRemarks: print the remarks selected by the -Rpass* regular expressions
+ * at their Slang source location, and record all remarks as YAML in
+ * context.optimizationRecord if -fsave-optimization-record is on. Also turns on
+ * line-table debug info, which is where the passes take remark locations from.
+ * Call before IR generation.
+ * @return false if a -Rpass* regular expression is invalid.
+ */
+bool setupRemarks(CodeGenContext &context);
+
+#endif //SLANG_REMARKS_H
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include "scheduler.h"
+
+namespace
+{
+struct WorkerQueue
+{
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+};
+}
+
+/*
+ * nextTask: the largest task of the worker's own deque, else the smallest
+ * task of the first other worker that has one.
+ * @return false when every deque is empty, no task is ever added later.
+ */
+static bool nextTask(std::vector<std::unique_ptr<WorkerQueue>> &queues, size_t self, size_t &task)
+{
+    {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        if (!queues[self]->tasks.empty())
+        {
+            task = queues[self]->tasks.front();
+            queues[self]->tasks.pop_front();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++)
+    {
+        WorkerQueue &victim = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void runWorkStealing(const std::vector<std::function<void()>> &tasks, const std::vector<uint64_t> &costs,
+                     unsigned workers)
+{
+    std::vector<size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b)
+    {
+        return costs[a] > costs[b];
+    });
+
+    workers = std::max(1u, std::min(workers, (unsigned) tasks.size()));
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    for (unsigned w = 0; w < workers; w++)
+    {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        queues[i % workers]->tasks.push_back(order[i]);
+    }
+
+    auto work = [&tasks, &queues](size_t self)
+    {
+        size_t task;
+        while (nextTask(queues, self, task))
+        {
+            tasks[task]();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < workers; w++)
+    {
+        threads.emplace_back(work, w);
+    }
+    // The calling thread is worker 0.
+    work(0);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef SLANG_SCHEDULER_H
+#define SLANG_SCHEDULER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/*
+ * runWorkStealing: run every task on a pool of worker threads and wait for
+ * all of them. Tasks are dealt to the workers' deques by decreasing cost;
+ * a worker takes the largest task of its own deque, and when that is empty
+ * steals the smallest one of another worker, so that one large task at the
+ * end doesn't leave the other workers idle.
+ * @param tasks -- the tasks, independent of each other.
+ * @param costs -- estimated cost of every task, e.g. the input size.
+ * @param workers -- number of threads, 1 runs the tasks on the calling thread.
+ */
+void runWorkStealing(const std::vector<std::function<void()>> &tasks, const std::vector<uint64_t> &costs,
+                     unsigned workers);
+
+#endif //SLANG_SCHEDULER_H
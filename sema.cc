@@ -0,0 +1,303 @@
+#include <unordered_map>
+#include <vector>
+#include <llvm/IR/DerivedTypes.h>
+#include "IR.h"
+#include "sema.h"
+
+namespace
+{
+
+class SemanticAnalysis
+{
+public:
+    explicit SemanticAnalysis(CodeGenContext &context) : context(context)
+    {}
+
+    void analyzeProgram(AST_Block &programBlock)
+    {
+        // IR generation opens a scope around the whole program.
+        scopes.emplace_back();
+        analyzeStatements(*programBlock.statements);
+        scopes.pop_back();
+    }
+
+private:
+    typedef std::unordered_map<std::string, Symbol *> Scope;
+
+    CodeGenContext &context;
+    // Local scopes, innermost last, then the globals they can shadow.
+    std::vector<Scope> scopes;
+    Scope globals;
+    Scope functions;
+    std::unordered_map<std::string, const StructInfo *> structs;
+
+    Symbol *lookup(const std::string &name) const
+    {
+        for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++)
+        {
+            auto it = scope->find(name);
+            if (it != scope->end())
+            {
+                return it->second;
+            }
+        }
+        auto it = globals.find(name);
+        return it != globals.end() ? it->second : nullptr;
+    }
+
+    void resolveType(AST_Identifier &type)
+    {
+        type.resolvedType = context.typeSystem.getVarType(type.name);
+    }
+
+    void declare(AST_VariableDeclaration &declaration, bool isFuncArg = false)
+    {
+        resolveType(*declaration.type);
+        Symbol *symbol = context.symbols.newSymbol();
+        symbol->type = declaration.type;
+        symbol->valueType = declaration.type->resolvedType;
+        auto structInfo = structs.find(declaration.type->name);
+        symbol->structInfo = structInfo != structs.end() ? structInfo->second : nullptr;
+        symbol->isFuncArg = isFuncArg;
+        declaration.id->symbol = symbol;
+        (declaration.isGlobal ? globals : scopes.back())[declaration.id->name] = symbol;
+    }
+
+    void analyzeStatements(AST_StatementList &statements)
+    {
+        for (auto &statement : statements)
+        {
+            analyzeStatement(*statement);
+        }
+    }
+
+    /*
+     * analyzeScope: a block that IR generation runs in a scope of its own.
+     */
+    void analyzeScope(AST_Block &block)
+    {
+        scopes.emplace_back();
+        analyzeStatements(*block.statements);
+        scopes.pop_back();
+    }
+
+    void analyzeStatement(AST_Statement &statement)
+    {
+        switch (statement.getKind())
+        {
+            case ASTKind::ExpressionStatement:
+                analyzeExpression(static_cast<AST_ExpressionStatement &>(statement).expression.get());
+                break;
+            case ASTKind::VariableDeclaration:
+            {
+                // The name is visible in its own initializer, as in IR generation.
+                auto &declaration = static_cast<AST_VariableDeclaration &>(statement);
+                declare(declaration);
+                analyzeExpression(declaration.assignmentExpr.get());
+                break;
+            }
+            case ASTKind::ArrayInitialization:
+            {
+                auto &initialization = static_cast<AST_ArrayInitialization &>(statement);
+                if (initialization.isGlobal)
+                {
+                    initialization.declaration->isGlobal = true;
+                }
+                declare(*initialization.declaration);
+                for (auto &expression : *initialization.expressionList)
+                {
+                    analyzeExpression(expression.get());
+                }
+                break;
+            }
+            case ASTKind::FunctionDeclaration:
+                analyzeFunction(static_cast<AST_FunctionDeclaration &>(statement));
+                break;
+            case ASTKind::StructDeclaration:
+                analyzeStruct(static_cast<AST_StructDeclaration &>(statement));
+                break;
+            case ASTKind::ReturnStatement:
+                analyzeExpression(static_cast<AST_ReturnStatement &>(statement).expression.get());
+                break;
+            case ASTKind::IfStatement:
+            {
+                auto &ifStatement = static_cast<AST_IfStatement &>(statement);
+                analyzeExpression(ifStatement.condition.get());
+                analyzeScope(*ifStatement.trueBlock);
+                if (ifStatement.falseBlock)
+                {
+                    analyzeScope(*ifStatement.falseBlock);
+                }
+                break;
+            }
+            case ASTKind::ForStatement:
+            {
+                auto &forStatement = static_cast<AST_ForStatement &>(statement);
+                analyzeExpression(forStatement.initial.get());
+                analyzeExpression(forStatement.condition.get());
+                analyzeExpression(forStatement.increment.get());
+                analyzeScope(*forStatement.block);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void analyzeFunction(AST_FunctionDeclaration &function)
+    {
+        resolveType(*function.type);
+        for (auto &argument : *function.arguments)
+        {
+            resolveType(*argument->type);
+        }
+        // A prototype and the definition are the same function.
+        Symbol *&symbol = functions[function.id->name];
+        if (!symbol)
+        {
+            symbol = context.symbols.newSymbol();
+            symbol->type = function.type;
+            symbol->valueType = function.type->resolvedType;
+        }
+        function.id->symbol = symbol;
+        if (function.isExternal)
+        {
+            return;
+        }
+
+        // Parameters and the body share the scope of the function.
+        scopes.emplace_back();
+        for (auto &argument : *function.arguments)
+        {
+            declare(*argument, true);
+        }
+        analyzeStatements(*function.block->statements);
+        scopes.pop_back();
+    }
+
+    void analyzeStruct(AST_StructDeclaration &structure)
+    {
+        auto structType = llvm::StructType::create(context.llvmContext, structure.name->name);
+        context.typeSystem.addStructType(structure.name->name, structType);
+
+        StructInfo *structInfo = context.symbols.newStructInfo();
+        std::vector<llvm::Type *> memberTypes;
+        for (auto &member : *structure.members)
+        {
+            resolveType(*member->type);
+            memberTypes.push_back(member->type->isArray ? llvm::PointerType::get(member->type->resolvedType, 0)
+                                                        : member->type->resolvedType);
+            // The first of two members with the same name wins.
+            structInfo->memberIndex.emplace(member->id->name, (long) memberTypes.size() - 1);
+        }
+        structType->setBody(memberTypes);
+        structs[structure.name->name] = structInfo;
+    }
+
+    void analyzeArrayIndex(AST_ArrayIndex &index)
+    {
+        index.arrayName->symbol = lookup(index.arrayName->name);
+        for (auto &expression : *index.expressions)
+        {
+            analyzeExpression(expression.get());
+        }
+    }
+
+    void analyzeStructMember(AST_StructMember &member)
+    {
+        Symbol *symbol = lookup(member.id->name);
+        member.id->symbol = symbol;
+        if (member.array)
+        {
+            analyzeArrayIndex(*member.array);
+        }
+        member.memberIndex = -1;
+        if (symbol && symbol->structInfo)
+        {
+            auto it = symbol->structInfo->memberIndex.find(member.member->name);
+            if (it != symbol->structInfo->memberIndex.end())
+            {
+                member.memberIndex = it->second;
+            }
+        }
+    }
+
+    void analyzeExpression(AST_Expression *expression)
+    {
+        if (!expression)
+        {
+            return;
+        }
+        switch (expression->getKind())
+        {
+            case ASTKind::Identifier:
+            {
+                auto identifier = static_cast<AST_Identifier *>(expression);
+                identifier->symbol = lookup(identifier->name);
+                break;
+            }
+            case ASTKind::MethodCall:
+            {
+                auto call = static_cast<AST_MethodCall *>(expression);
+                auto it = functions.find(call->id->name);
+                call->id->symbol = it != functions.end() ? it->second : nullptr;
+                if (call->arguments)
+                {
+                    for (auto &argument : *call->arguments)
+                    {
+                        analyzeExpression(argument.get());
+                    }
+                }
+                break;
+            }
+            case ASTKind::BinaryOperator:
+            {
+                auto binary = static_cast<AST_BinaryOperator *>(expression);
+                analyzeExpression(binary->lhs.get());
+                analyzeExpression(binary->rhs.get());
+                break;
+            }
+            case ASTKind::Assignment:
+            {
+                auto assignment = static_cast<AST_Assignment *>(expression);
+                assignment->lhs->symbol = lookup(assignment->lhs->name);
+                analyzeExpression(assignment->rhs.get());
+                break;
+            }
+            case ASTKind::Block:
+                // Unlike the blocks of statements, it has no scope of its own.
+                analyzeStatements(*static_cast<AST_Block *>(expression)->statements);
+                break;
+            case ASTKind::ArrayIndex:
+                analyzeArrayIndex(*static_cast<AST_ArrayIndex *>(expression));
+                break;
+            case ASTKind::ArrayAssignment:
+            {
+                auto assignment = static_cast<AST_ArrayAssignment *>(expression);
+                analyzeArrayIndex(*assignment->arrayIndex);
+                analyzeExpression(assignment->expression.get());
+                break;
+            }
+            case ASTKind::StructMember:
+                analyzeStructMember(*static_cast<AST_StructMember *>(expression));
+                break;
+            case ASTKind::StructAssignment:
+            {
+                auto assignment = static_cast<AST_StructAssignment *>(expression);
+                analyzeStructMember(*assignment->structMember);
+                analyzeExpression(assignment->expression.get());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+};
+
+}
+
+void analyzeProgram(AST_Block &programBlock, CodeGenContext &context)
+{
+    SemanticAnalysis analysis(context);
+    analysis.analyzeProgram(programBlock);
+}
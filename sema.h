@@ -0,0 +1,82 @@
+#ifndef SLANG_SEMA_H
+#define SLANG_SEMA_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <llvm/IR/Type.h>
+#include <llvm/IR/Value.h>
+#include "absyn.h"
+
+class CodeGenContext;
+
+/*
+ * StructInfo: the member indices of a struct, by member name.
+ */
+struct StructInfo
+{
+    std::unordered_map<std::string, long> memberIndex;
+};
+
+/*
+ * Symbol: a declared variable, parameter or function. Every use of a name in
+ * the AST points to the Symbol of the declaration it refers to. IR generation
+ * reaches the declaration before any use, and fills in what only it knows.
+ */
+struct Symbol
+{
+    // Declared type, the return type of a function.
+    std::shared_ptr<AST_Identifier> type;
+    // What the type name denotes, the element type of an array: assignments convert to it.
+    llvm::Type *valueType = nullptr;
+    // Members of valueType if it is a struct, nullptr otherwise.
+    const StructInfo *structInfo = nullptr;
+    bool isFuncArg = false;
+
+    // Set by IR generation: the alloca, global or function, and the dimensions of an array.
+    llvm::Value *value = nullptr;
+    std::vector<uint64_t> arraySizes;
+
+    // Set by the MIR lowering, see mir.h: the mir::Variable or mir::Function, and
+    // the instruction that yields the address of a local in the function lowered.
+    uint32_t mirIndex = UINT32_MAX;
+    uint32_t mirAddress = UINT32_MAX;
+};
+
+/*
+ * SymbolArena: owns the symbols and struct members the AST points to, the pointers
+ * are valid while it lives.
+ */
+class SymbolArena
+{
+public:
+    Symbol *newSymbol()
+    {
+        symbols.emplace_back();
+        return &symbols.back();
+    }
+
+    StructInfo *newStructInfo()
+    {
+        structInfos.emplace_back();
+        return &structInfos.back();
+    }
+
+private:
+    std::deque<Symbol> symbols;
+    std::deque<StructInfo> structInfos;
+};
+
+/*
+ * analyzeProgram: resolve every name in the AST to its Symbol, every type
+ * name to its llvm::Type and every struct member to its index, and create the
+ * struct types. Names are bound in program order with the scopes IR generation
+ * uses, so that it can run without a single string lookup. Names that don't
+ * resolve are left nullptr for IR generation to report where they are used.
+ */
+void analyzeProgram(AST_Block &programBlock, CodeGenContext &context);
+
+#endif //SLANG_SEMA_H
@@ -4,41 +4,107 @@
 #include <llvm/CodeGen/MIRParser/MIRParser.h>
 #include <llvm/CodeGen/MachineFunctionPass.h>
 #include <llvm/CodeGen/MachineModuleInfo.h>
+#include <llvm/CodeGen/ParallelCG.h>
 #include <llvm/CodeGen/TargetPassConfig.h>
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
+#include <llvm/Bitcode/BitcodeWriterPass.h>
 #include <llvm/IR/IRPrintingPasses.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/FormattedStream.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/Path.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/ToolOutputFile.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
+#include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <mutex>
 #include "IR.h"
+#include "diagnostics.h"
+#include "optimize.h"
+#include "remarks.h"
 #include "target_gen.h"
 #include "debug.h"
 
 using namespace llvm;
 
-extern bool EmitIR;
-extern bool EmitASM;
-extern std::string Prefix;
+/*
+ * getCodeGenOptLevel: backend optimization level matching the -O flag.
+ */
+CodeGenOpt::Level getCodeGenOptLevel(const Options &options)
+{
+    switch (parseOptimizationLevel(options.OptimizationLevel))
+    {
+        case 0:
+            return CodeGenOpt::None;
+        case 1:
+            return CodeGenOpt::Less;
+        case 2:
+            return CodeGenOpt::Default;
+        default:
+            return CodeGenOpt::Aggressive;
+    }
+}
 
-void generateTarget(CodeGenContext &context, const std::string &filename)
+/*
+ * getCPUStr: CPU name passed to the backend, resolving -march=native.
+ */
+std::string getCPUStr(const Options &options)
 {
-    // Initialize the target registry etc.
-    InitializeAllTargetInfos();
-    InitializeAllTargets();
-    InitializeAllTargetMCs();
-    InitializeAllAsmParsers();
-    InitializeAllAsmPrinters();
-
-    auto TargetTriple = sys::getDefaultTargetTriple();
-    context.theModule->setTargetTriple(TargetTriple);
+    if (options.TargetCPU == "native")
+    {
+        return sys::getHostCPUName();
+    }
+    return options.TargetCPU;
+}
+
+/*
+ * getFeaturesStr: feature string for the backend, host features for
+ * -march=native followed by the explicit -mattr list.
+ */
+std::string getFeaturesStr(const Options &options)
+{
+    SubtargetFeatures Features;
+
+    if (options.TargetCPU == "native")
+    {
+        StringMap<bool> HostFeatures;
+        if (sys::getHostCPUFeatures(HostFeatures))
+        {
+            for (auto &F : HostFeatures)
+            {
+                Features.AddFeature(F.first(), F.second);
+            }
+        }
+    }
+
+    SmallVector<StringRef, 8> Attrs;
+    StringRef(options.TargetFeatures).split(Attrs, ",", -1, false);
+    for (auto &Attr : Attrs)
+    {
+        Features.AddFeature(Attr.trim());
+    }
+
+    return Features.getString();
+}
+
+/*
+ * getTargetTriple: triple given by -target, or the host triple.
+ */
+std::string getTargetTriple(const Options &options)
+{
+    return options.TargetTripleName.empty() ? sys::getDefaultTargetTriple()
+                                            : Triple::normalize(options.TargetTripleName);
+}
+
+std::unique_ptr<TargetMachine> createTargetMachine(const Options &options)
+{
+    auto TargetTriple = getTargetTriple(options);
 
     /*
      * Print an error and exit if we couldn't find the requested target.
@@ -50,72 +116,224 @@ void generateTarget(CodeGenContext &context, const std::string &filename)
 
     if (!Target)
     {
-        errs() << error;
-        return;
+        reportDiagnostic("slang:\033[1;31m error:\033[0m %s\n", error.c_str());
+        return nullptr;
     }
 
-    auto CPU = "generic";
-    auto features = "";
-
+    auto CPU = getCPUStr(options);
+    auto features = getFeaturesStr(options);
+    auto OL = getCodeGenOptLevel(options);
     TargetOptions opt;
+    // At -O0 favour compile latency: FastISel and, implied by CodeGenOpt::None, the fast register allocator.
+    opt.EnableFastISel = OL == CodeGenOpt::None;
     auto RM = Optional<Reloc::Model>();
-    auto TargetMachine = Target->createTargetMachine(TargetTriple, CPU, features, opt, RM);
+    std::unique_ptr<TargetMachine> TM(Target->createTargetMachine(TargetTriple, CPU, features, opt, RM, None, OL));
+    TM->setFastISel(OL == CodeGenOpt::None);
+    return TM;
+}
 
-    context.theModule->setDataLayout(TargetMachine->createDataLayout());
-    context.theModule->setTargetTriple(TargetTriple);
+void initializeTargetRegistry(const Options &options)
+{
+    // Compiles running in parallel all get here, the registry is filled once.
+    static std::once_flag nativeInitialized;
+    static std::once_flag allInitialized;
 
-    // Build up all of the passes that we want to do to the module.
-    legacy::PassManager PM;
-    std::error_code EC;
-    sys::fs::OpenFlags OpenFlags = sys::fs::F_None;
-    if (EmitIR || EmitASM)
+    // Initialize only what we need: the host target, or every target for cross builds.
+    if (options.TargetTripleName.empty())
+    {
+        std::call_once(nativeInitialized, []()
+        {
+            InitializeNativeTarget();
+            InitializeNativeTargetAsmParser();
+            InitializeNativeTargetAsmPrinter();
+        });
+    } else
     {
-        OpenFlags |= sys::fs::F_Text;
+        std::call_once(allInitialized, []()
+        {
+            InitializeAllTargetInfos();
+            InitializeAllTargets();
+            InitializeAllTargetMCs();
+            InitializeAllAsmParsers();
+            InitializeAllAsmPrinters();
+        });
     }
-    raw_fd_ostream OS(filename, EC, OpenFlags);
+}
 
-    if (EC)
+void initializeTarget(CodeGenContext &context)
+{
+    const Options &options = context.options;
+    initializeTargetRegistry(options);
+
+    auto TargetTriple = getTargetTriple(options);
+    context.theModule->setTargetTriple(TargetTriple);
+
+    context.targetMachine = createTargetMachine(options);
+    if (!context.targetMachine)
     {
-        errs() << "Could not open file: " << EC.message();
         return;
     }
 
-    if (EmitIR)
+    auto CPU = getCPUStr(options);
+    // The backend has no separate tuning CPU, scheduling always follows the selected CPU.
+    if (!options.TargetTuneCPU.empty() && options.TargetTuneCPU != CPU)
     {
-        PM.add(createPrintModulePass(OS));
-        PM.run(*context.theModule);
-        OS.flush();
-        return;
+        reportDiagnostic("slang:\033[1;35m warning:\033[0m -mtune=%s is ignored, tuning for '%s'\n",
+                         options.TargetTuneCPU.c_str(), CPU.c_str());
+    }
+
+#ifdef OBJ_DEBUG
+    outs() << "Target: " << TargetTriple << ", CPU: " << CPU << ", features: " << getFeaturesStr(options) << "\n";
+#endif
+
+    context.theModule->setDataLayout(context.targetMachine->createDataLayout());
+    context.theModule->setTargetTriple(TargetTriple);
+}
+
+/*
+ * generatePartitions: split the module and run instruction selection and
+ * emission for every partition on its own thread.
+ * @return the objects, one per partition.
+ */
+static std::vector<std::string> generatePartitions(CodeGenContext &context)
+{
+    unsigned partitions = context.options.CodeGenPartitions;
+    std::vector<SmallString<0>> buffers(partitions);
+    std::vector<std::unique_ptr<raw_svector_ostream>> streams;
+    std::vector<raw_pwrite_stream *> OSs;
+    for (auto &buffer : buffers)
+    {
+        streams.emplace_back(new raw_svector_ostream(buffer));
+        OSs.push_back(streams.back().get());
     }
 
-    LLVMTargetMachine &LLVMTM = dynamic_cast<LLVMTargetMachine &>(*TargetMachine);
-    MachineModuleInfo *MMI = new MachineModuleInfo(&LLVMTM);
-    TargetMachine::CodeGenFileType FileType = TargetMachine::CGFT_ObjectFile;
-    if (EmitASM)
+    // Each partition gets a private TargetMachine from the factory.
+    const Options &options = context.options;
+    splitCodeGen(std::move(context.theModule), OSs, {}, [&options]()
     {
-        FileType = TargetMachine::CGFT_AssemblyFile;
+        return createTargetMachine(options);
+    }, TargetMachine::CGFT_ObjectFile);
+
+    std::vector<std::string> objects;
+    for (auto &buffer : buffers)
+    {
+        objects.push_back(buffer.str().str());
+    }
+#ifdef OBJ_DEBUG
+    outs() << "Object code generated in " << partitions << " partitions\n";
+#endif
+    return objects;
+}
 
-        if (TargetMachine->addPassesToEmitFile(PM, OS, FileType, true, MMI))
+enum class OutputKind
+{
+    Object,
+    Assembly,
+    IR,
+    Bitcode
+};
+
+/*
+ * emitModule: produce the module as textual IR, bitcode, assembly or object code.
+ * Assembly and objects run the backend, which rewrites the IR while lowering it.
+ * @param output -- receives the bytes.
+ * @return whether the target could produce the output.
+ */
+static bool emitModule(Module &module, TargetMachine &TM, std::string &output, OutputKind kind)
+{
+    SmallString<0> buffer;
+    raw_svector_ostream OS(buffer);
+
+    legacy::PassManager PM;
+    if (kind == OutputKind::IR)
+    {
+        PM.add(createPrintModulePass(OS));
+    } else if (kind == OutputKind::Bitcode)
+    {
+        PM.add(createBitcodeWriterPass(OS));
+    } else
+    {
+        LLVMTargetMachine &LLVMTM = dynamic_cast<LLVMTargetMachine &>(TM);
+        MachineModuleInfo *MMI = new MachineModuleInfo(&LLVMTM);
+        TargetMachine::CodeGenFileType FileType =
+                kind == OutputKind::Assembly ? TargetMachine::CGFT_AssemblyFile : TargetMachine::CGFT_ObjectFile;
+        if (TM.addPassesToEmitFile(PM, OS, FileType, true, MMI))
         {
-            errs() << "TargetMachine can't emit a file of this type";
-            return;
+            reportDiagnostic("slang:\033[1;31m error:\033[0m target can't emit a file of this type\n");
+            return false;
         }
-        std::string OutputFile = "clang -Wno-everything -S " + Prefix + ".c" + " -o " + filename;
-        system(OutputFile.c_str());
-        return;
+    }
+    PM.run(module);
+
+    output = buffer.str().str();
+    return true;
+}
+
+/*
+ * saveTemps: for -save-temps, textual IR, bitcode and assembly of the one
+ * optimized module, next to the requested output.
+ */
+static void saveTemps(CodeGenContext &context, CompileResult &result)
+{
+    emitModule(*context.theModule, *context.targetMachine, result.savedIR, OutputKind::IR);
+    emitModule(*context.theModule, *context.targetMachine, result.savedBitcode, OutputKind::Bitcode);
+    // The backend changes the module it runs on, keep the original for the real output.
+    std::unique_ptr<Module> clone = CloneModule(context.theModule.get());
+    emitModule(*clone, *context.targetMachine, result.savedAssembly, OutputKind::Assembly);
+}
+
+bool generateTarget(CodeGenContext &context, CompileResult &result)
+{
+    const Options &options = context.options;
+    // The TargetMachine is shared with the optimizer, see initializeTarget().
+    if (!context.targetMachine)
+    {
+        reportDiagnostic("slang:\033[1;31m error:\033[0m no target machine for module %s\n",
+                         context.theModule->getName().str().c_str());
+        return false;
     }
 
-    if (TargetMachine->addPassesToEmitFile(PM, OS, FileType, true, MMI))
+    OutputKind kind = OutputKind::Object;
+    if (options.EmitIR)
     {
-        errs() << "TargetMachine can't emit a file of this type";
-        return;
+        kind = OutputKind::IR;
+    } else if (options.EmitBC)
+    {
+        kind = OutputKind::Bitcode;
+    } else if (options.EmitASM)
+    {
+        kind = OutputKind::Assembly;
     }
 
-    PM.run(*context.theModule);
-    OS.flush();
+    if (options.SaveTemps)
+    {
+        saveTemps(context, result);
+    }
 
+    if (options.ThinLTO && kind != OutputKind::IR)
+    {
+        // Bitcode with a module summary index, code is generated at link time.
+        SmallString<0> buffer;
+        raw_svector_ostream OS(buffer);
+        legacy::PassManager PM;
+        PM.add(createWriteThinLTOBitcodePass(OS));
+        PM.run(*context.theModule);
+        result.outputs = {buffer.str().str()};
+        return true;
+    }
 
-#ifdef OBJ_DEBUG
-    outs() << "Object code wrote to " << filename.c_str() << "\n";
-#endif
+    // Partitions are generated in their own contexts, which would lose the backend's remarks.
+    if (options.CodeGenPartitions > 1 && kind == OutputKind::Object && !remarksRequested(options))
+    {
+        result.outputs = generatePartitions(context);
+        return true;
+    }
+
+    std::string output;
+    if (!emitModule(*context.theModule, *context.targetMachine, output, kind))
+    {
+        return false;
+    }
+    result.outputs = {std::move(output)};
+    return true;
 }
@@ -1,9 +1,50 @@
 #ifndef SLANG_TARGET_GEN_H
 #define SLANG_TARGET_GEN_H
 
+#include <memory>
 #include <string>
+#include <vector>
+#include <llvm/Target/TargetMachine.h>
 #include "IR.h"
+#include "compiler.h"
+#include "options.h"
 
-void generateTarget(CodeGenContext &context, const std::string &filename = "output.o");
+/*
+ * Target description selected by -target, -march/-mcpu, -mattr and -O.
+ */
+std::string getTargetTriple(const Options &options);
 
-#endif //SLANG_OBJ_GEN_H
+std::string getCPUStr(const Options &options);
+
+std::string getFeaturesStr(const Options &options);
+
+llvm::CodeGenOpt::Level getCodeGenOptLevel(const Options &options);
+
+/*
+ * initializeTargetRegistry: register the selected target with LLVM.
+ * Safe to call from several threads, the registry is filled once.
+ */
+void initializeTargetRegistry(const Options &options);
+
+/*
+ * createTargetMachine: create a TargetMachine for the selected target,
+ * nullptr if the target is unknown. The target must have been registered by
+ * initializeTargetRegistry() before.
+ */
+std::unique_ptr<llvm::TargetMachine> createTargetMachine(const Options &options);
+
+/*
+ * initializeTarget: create the TargetMachine for the host and attach its
+ * triple and DataLayout to the module, so that both the optimizer and the
+ * backend work against the same target description.
+ */
+void initializeTarget(CodeGenContext &context);
+
+/*
+ * generateTarget: emit the optimized module into result.outputs, several
+ * objects when code generation is partitioned, and the -save-temps outputs.
+ * @return false if the target can't produce the requested output.
+ */
+bool generateTarget(CodeGenContext &context, CompileResult &result);
+
+#endif //SLANG_TARGET_GEN_H
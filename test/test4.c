@@ -0,0 +1,34 @@
+extern int printf(char str, int arg1);
+
+extern int puts(char str);
+
+double a[1024];
+double b[1024];
+double c[1024];
+
+int main()
+{
+    int i;
+    double sum = 0.0;
+
+    for (i = 0; i < 1024; i++)
+    {
+        a[i] = i * 0.5;
+        b[i] = i * 2.0;
+    }
+
+    /* Vectorized at -O2, with the vector width of the target, see bench/march.sh. */
+    for (i = 0; i < 1024; i++)
+    {
+        c[i] = a[i] * b[i] + c[i];
+    }
+
+    for (i = 0; i < 1024; i++)
+    {
+        sum += c[i];
+    }
+    printf("sum = %lf", sum);
+    puts("");
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <llvm/ADT/Statistic.h>
+#include <llvm/Pass.h>
+#include <llvm/Support/Timer.h>
+#include <llvm/Support/raw_ostream.h>
+#include "time_report.h"
+
+namespace
+{
+    struct TimeRecord
+    {
+        std::string phase;
+        std::string detail;
+        // Microseconds since the report started.
+        int64_t begin;
+        int64_t wall;
+        int64_t user;
+        int64_t system;
+        // Peak resident set size in KB when the region ended.
+        long peakRSS;
+        unsigned thread;
+    };
+
+    /*
+     * The registry of the process: regions of every thread and every compile
+     * land in it. Regions read the flags from any thread, origin is only
+     * written before timingEnabled turns on.
+     */
+    std::atomic<bool> timingEnabled(false);
+    std::atomic<bool> phasePeaks(false);
+    std::chrono::steady_clock::time_point origin;
+    std::mutex recordsMutex;
+    std::vector<TimeRecord> records;
+    std::map<std::thread::id, unsigned> threads;
+
+    int64_t microseconds(const struct timeval &tv)
+    {
+        return (int64_t) tv.tv_sec * 1000000 + tv.tv_usec;
+    }
+
+    /*
+     * highWaterMark: peak resident set size in KB since the last resetHighWaterMark().
+     */
+    long highWaterMark()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+            {
+                return atol(line.c_str() + 6);
+            }
+        }
+        return 0;
+    }
+
+    /*
+     * resetHighWaterMark: restart the peak RSS at the current RSS (Linux 4.0 and newer).
+     * This resets it for the whole process, hence phasePeakRSS only for one compile at a time.
+     */
+    void resetHighWaterMark()
+    {
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+    }
+
+    /*
+     * sumPhases: phase regions summed by phase, in order of first appearance.
+     * @param functions -- receives the per-function regions.
+     */
+    std::vector<TimeRecord> sumPhases(std::vector<TimeRecord> &functions)
+    {
+        std::vector<TimeRecord> phases;
+        std::map<std::string, size_t> index;
+        for (auto &record : records)
+        {
+            if (!record.detail.empty())
+            {
+                functions.push_back(record);
+                continue;
+            }
+            auto it = index.find(record.phase);
+            if (it == index.end())
+            {
+                index[record.phase] = phases.size();
+                phases.push_back(record);
+            } else
+            {
+                auto &phase = phases[it->second];
+                phase.wall += record.wall;
+                phase.user += record.user;
+                phase.system += record.system;
+                phase.peakRSS = std::max(phase.peakRSS, record.peakRSS);
+            }
+        }
+        return phases;
+    }
+
+    std::string escape(const std::string &str)
+    {
+        std::string escaped;
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+TimeRegion::TimeRegion(const std::string &phase, const std::string &detail) : enabled(timingEnabled)
+{
+    if (!enabled)
+        return;
+    this->phase = phase;
+    this->detail = detail;
+    if (phasePeaks && detail.empty())
+    {
+        resetHighWaterMark();
+    }
+    getrusage(RUSAGE_SELF, &usage);
+    start = std::chrono::steady_clock::now();
+}
+
+TimeRegion::~TimeRegion()
+{
+    if (!enabled)
+        return;
+    auto end = std::chrono::steady_clock::now();
+    struct rusage now;
+    getrusage(RUSAGE_SELF, &now);
+
+    TimeRecord record;
+    record.phase = phase;
+    record.detail = detail;
+    record.begin = std::chrono::duration_cast<std::chrono::microseconds>(start - origin).count();
+    record.wall = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    // Process-wide CPU time, it includes worker threads of parallel phases.
+    record.user = microseconds(now.ru_utime) - microseconds(usage.ru_utime);
+    record.system = microseconds(now.ru_stime) - microseconds(usage.ru_stime);
+    record.peakRSS = phasePeaks && detail.empty() ? highWaterMark() : now.ru_maxrss;
+
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    auto thread = threads.insert(std::make_pair(std::this_thread::get_id(), (unsigned) threads.size()));
+    record.thread = thread.first->second;
+    records.push_back(record);
+}
+
+void startTimeReport(bool passTimers, bool phasePeakRSS)
+{
+    phasePeaks = phasePeakRSS;
+    origin = std::chrono::steady_clock::now();
+    // Last, a region that sees timing enabled sees origin too.
+    timingEnabled = true;
+    if (passTimers)
+    {
+        // Per-pass timers of every legacy PassManager, instruction selection and emission included.
+        llvm::TimePassesIsEnabled = true;
+        // Counters are only collected by LLVM builds with assertions or LLVM_FORCE_ENABLE_STATS.
+        llvm::EnableStatistics(false);
+    }
+}
+
+void printTimeReport()
+{
+    std::lock_guard<std::mutex> lock(recordsMutex);
+
+    // Phases in order of first appearance, functions sorted by wall time.
+    std::vector<TimeRecord> functions;
+    std::vector<TimeRecord> phases = sumPhases(functions);
+    int64_t total = 0;
+    for (auto &phase : phases)
+    {
+        total += phase.wall;
+    }
+    std::sort(functions.begin(), functions.end(), [](const TimeRecord &a, const TimeRecord &b) {
+        return a.wall > b.wall;
+    });
+
+    auto printRow = [](const TimeRecord &record, const std::string &name) {
+        fprintf(stderr, "  %10.4f  %10.4f  %10.4f  %10ld  %s\n", record.wall / 1e6, record.user / 1e6,
+                record.system / 1e6, record.peakRSS, name.c_str());
+    };
+
+    fprintf(stderr, "===%s===\n", std::string(73, '-').c_str());
+    fprintf(stderr, "%*s\n", 52, "Slang compile time report");
+    fprintf(stderr, "===%s===\n", std::string(73, '-').c_str());
+    fprintf(stderr, "  Total Wall Time: %.4f seconds\n\n", total / 1e6);
+    fprintf(stderr, "  %10s  %10s  %10s  %10s  %s\n", "Wall (s)", "User (s)", "System (s)", "RSS (KB)", "Phase");
+    for (auto &phase : phases)
+    {
+        printRow(phase, phase.phase);
+    }
+
+    if (!functions.empty())
+    {
+        fprintf(stderr, "\n  %10s  %10s  %10s  %10s  %s\n", "Wall (s)", "User (s)", "System (s)", "RSS (KB)",
+                "Function");
+        for (auto &record : functions)
+        {
+            printRow(record, record.phase + ": " + record.detail);
+        }
+    }
+    fprintf(stderr, "\n");
+
+    llvm::TimerGroup::printAll(llvm::errs());
+    llvm::PrintStatistics(llvm::errs());
+}
+
+std::vector<PhaseTime> collectPhaseTimes()
+{
+    std::lock_guard<std::mutex> lock(recordsMutex);
+
+    std::vector<TimeRecord> functions;
+    std::vector<PhaseTime> times;
+    for (auto &phase : sumPhases(functions))
+    {
+        times.push_back({phase.phase, phase.wall / 1e6, phase.user / 1e6, phase.system / 1e6, phase.peakRSS});
+    }
+    return times;
+}
+
+void clearTimeReport()
+{
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    records.clear();
+}
+
+void writeTimeTrace(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(recordsMutex);
+
+    std::ofstream os(filename);
+    if (!os.is_open())
+    {
+        fprintf(stderr, "slang:\033[1;31m error:\033[0m cannot write time trace to '%s'\n", filename.c_str());
+        return;
+    }
+    os << "{\"traceEvents\":[";
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        auto &record = records[i];
+        auto &name = record.detail.empty() ? record.phase : record.detail;
+        os << (i ? "," : "") << "\n{\"name\":\"" << escape(name) << "\",\"cat\":\"" << escape(record.phase)
+           << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.thread << ",\"ts\":" << record.begin << ",\"dur\":"
+           << record.wall << ",\"args\":{\"user_us\":" << record.user << ",\"system_us\":" << record.system
+           << ",\"peak_rss_kb\":" << record.peakRSS << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
@@ -0,0 +1,78 @@
+#ifndef SLANG_TIME_REPORT_H
+#define SLANG_TIME_REPORT_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+/*
+ * TimeRegion: times a compiler phase for -ftime-report and -ftime-trace
+ * for as long as the object lives. Costs nothing unless one of them is on.
+ */
+class TimeRegion
+{
+public:
+    /*
+     * @param phase -- phase name, e.g. "IR generation".
+     * @param detail -- optional sub-item such as a function name.
+     */
+    explicit TimeRegion(const std::string &phase, const std::string &detail = "");
+
+    ~TimeRegion();
+
+private:
+    bool enabled;
+    std::string phase;
+    std::string detail;
+    std::chrono::steady_clock::time_point start;
+    struct rusage usage;
+};
+
+/*
+ * startTimeReport: enable timing of the regions of all threads, and LLVM
+ * pass timers and statistics if passTimers is set. The report is for the
+ * whole process, not one compile: the driver and the benchmarks turn it on,
+ * slang_core only records into it. Call once, before the first TimeRegion.
+ * @param phasePeakRSS -- report the peak RSS reached within each phase
+ * instead of the process's peak so far. Phases must then run one at a time.
+ */
+void startTimeReport(bool passTimers, bool phasePeakRSS = false);
+
+/*
+ * printTimeReport: print wall/user/system time and peak RSS per phase and
+ * per function, followed by the LLVM pass timers and statistics.
+ */
+void printTimeReport();
+
+/*
+ * PhaseTime: all regions of one phase, summed. Times are in seconds.
+ */
+struct PhaseTime
+{
+    std::string phase;
+    double wall;
+    double user;
+    double system;
+    // KB, the largest of the phase's regions.
+    long peakRSS;
+};
+
+/*
+ * collectPhaseTimes: the phases recorded so far, in order of first appearance.
+ */
+std::vector<PhaseTime> collectPhaseTimes();
+
+/*
+ * clearTimeReport: drop the regions recorded so far, e.g. between repetitions of a benchmark.
+ */
+void clearTimeReport();
+
+/*
+ * writeTimeTrace: write all regions as Chrome trace-event JSON, viewable
+ * in chrome://tracing or Perfetto.
+ * @param filename -- the output file.
+ */
+void writeTimeTrace(const std::string &filename);
+
+#endif //SLANG_TIME_REPORT_H
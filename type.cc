@@ -55,19 +55,9 @@ TypeSystem::TypeSystem(LLVMContext &context) : llvmContext(context)
     addCast(intTy, intTy, llvm::CastInst::SExt);
 }
 
-void TypeSystem::addStructMember(string structName, string memType, string memName)
-{
-    if (this->_structTypes.find(structName) == this->_structTypes.end())
-    {
-        // LogError("Unknown struct name");
-    }
-    this->_structMembers[structName].push_back(std::make_pair(memType, memName));
-}
-
 void TypeSystem::addStructType(string name, llvm::StructType *type)
 {
     this->_structTypes[name] = type;
-    this->_structMembers[name] = std::vector<TypeNamePair>();
 }
 
 Type *TypeSystem::getVarType(const AST_Identifier &type)
@@ -130,27 +120,6 @@ bool TypeSystem::isStruct(string typeStr) const
     return this->_structTypes.find(typeStr) != this->_structTypes.end();
 }
 
-long TypeSystem::getStructMemberIndex(string structName, string memberName, int row, int col)
-{
-    if (this->_structTypes.find(structName) == this->_structTypes.end())
-    {
-        // LogError("Unknown struct name");
-        return 0;
-    }
-    auto &members = this->_structMembers[structName];
-    for (auto it = members.begin(); it != members.end(); it++)
-    {
-        if (it->second == memberName)
-        {
-            return std::distance(members.begin(), it);
-        }
-    }
-
-    LogErrorV(row, col, "no member named '" + memberName + "' in 'struct " + structName + "'");
-
-    return 0;
-}
-
 Type *TypeSystem::getVarType(string typeStr)
 {
 
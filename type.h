@@ -16,14 +16,10 @@
 using std::string;
 using namespace llvm;
 
-
-using TypeNamePair = std::pair<std::string, std::string>;
-
 class TypeSystem
 {
 private:
     LLVMContext &llvmContext;
-    std::map<string, std::vector<TypeNamePair>> _structMembers;
     std::map<string, llvm::StructType *> _structTypes;
     std::map<Type *, std::map<Type *, CastInst::CastOps>> _castTable;
 
@@ -42,10 +38,6 @@ public:
 
     void addStructType(string structName, llvm::StructType *);
 
-    void addStructMember(string structName, string memType, string memName);
-
-    long getStructMemberIndex(string structName, string memberName, int row, int col);
-
     Type *getVarType(const AST_Identifier &type);
 
     Type *getVarType(string typeStr);